@@ -66,6 +66,9 @@ int main(void){
 
 	setCustomFitnessFunction(params, meanSquareError, "MSE");
 
+	/* meanSquareError only depends on the active genes, so fitness values can be reused */
+	setReuseFitness(params, 1);
+
 	printParameters(params);
 
 	freeParameters(params);
@@ -22,10 +22,48 @@
 #include <time.h>
 #include <math.h>
 #include <float.h>
+#include <stdarg.h>
+#include <stdint.h>
 
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+/*
+	Binary dataSet files can be memory mapped, rather than read, where
+	POSIX memory mapping is available.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define MEMORYMAPPING
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* the nanoseconds of the time a file was last modified */
+#ifdef __APPLE__
+#define MODIFIEDNANOSECONDS(fileStat) ((fileStat).st_mtimespec.tv_nsec)
+#else
+#define MODIFIEDNANOSECONDS(fileStat) ((fileStat).st_mtim.tv_nsec)
+#endif
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "cgp.h"
 
+/*
+	Chromosomes can be compiled to native code where shared objects
+	can be built with a local compiler and loaded at run time.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define NATIVECOMPILATION
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
 /*
 	Hard limits on the size of the function set
 	and the names of various functions.
@@ -38,6 +76,113 @@
 #define SELECTIONSCHEMENAMELENGTH 21
 #define REPRODUCTIONSCHEMENAMELENGTH 21
 
+/*
+	Number of samples executed together by executeChromosomeBatch.
+	Each active node is applied to a whole block of samples before
+	moving onto the next node.
+*/
+#define SAMPLEBLOCKSIZE 128
+
+/*
+	Where the compiler and platform support it, the arithmetic sample block
+	node functions are compiled for several x86-64 instruction sets and the
+	widest supported by the CPU is selected at load time. The baseline
+	x86-64 version uses SSE2.
+
+	The vectorised functions give results identical to the scalar node
+	functions; IEEE addition, subtraction, multiplication, division and
+	square root are exactly rounded at any vector width. The weighted
+	input sum is built with floating point contraction disabled so the
+	AVX-512 version cannot fuse the multiply and add, which would change
+	the rounding. Transcendental functions are left to the C library.
+*/
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define BLOCKFUNCTIONTARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+#define WEIGHTEDSUMTARGETS __attribute__((target_clones("avx512f", "avx2", "default"), optimize("fp-contract=off")))
+#endif
+#endif
+
+#ifndef BLOCKFUNCTIONTARGETS
+#define BLOCKFUNCTIONTARGETS
+#define WEIGHTEDSUMTARGETS
+#endif
+
+/*
+	The maximum number of compiled chromosomes kept. Compiled code is
+	never unloaded as chromosomes may still refer to it; once the cache
+	is full further chromosomes are executed by the interpreter.
+*/
+#define COMPILEDCHROMOSOMECACHESIZE 4096
+
+/*
+	Starting value of the FNV-1a hashes used to identify genotypes
+*/
+#define HASHOFFSETBASIS 14695981039346656037ULL
+
+/*
+	Default number of fitness values kept by the fitness cache
+*/
+#define FITNESSCACHESIZE 10000
+
+/*
+	Number of generations after which runCGP retries evaluating the
+	children serially or in parallel, whichever is not currently faster
+*/
+#define PARALLELEVALUATIONRETRYPERIOD 64
+
+/*
+	Number of sample blocks in each task when the samples of a large
+	dataSet are shared between the threads of a team
+*/
+#define SAMPLETASKBLOCKS 8
+
+/*
+	Number of 64 bit words, each holding 64 samples, each node is applied
+	to at once when Boolean chromosomes are evaluated bit-parallel. Must be
+	a multiple of SAMPLEBLOCKSIZE / 64.
+*/
+#define BOOLEANBLOCKWORDS 64
+
+/*
+	Margin, relative to the cutoff plus one, by which the single precision
+	fitness of a screened child must exceed the cutoff for the child to be
+	rejected without being evaluated in double precision
+*/
+#define SCREENINGMARGIN 1e-3
+
+/*
+	One in this many screened out children, chosen by their active genotype
+	hash, is also evaluated in double precision to estimate the time saved
+*/
+#define SCREENINGSAMPLEPERIOD 32
+
+/*
+	Alignment in bytes of the values of a dataSet, one cache line, and so
+	also of each column in the column layout
+*/
+#define DATASETALIGNMENT 64
+
+/*
+	Minimum number of bytes of a text dataSet file parsed by each thread
+*/
+#define PARSECHUNKSIZE (1 << 20)
+
+/*
+	The version of the binary dataSet file format written by
+	saveDataSetBinary, and the value written to mark the byte order
+*/
+#define BINARYDATASETVERSION 1
+#define BINARYDATASETBYTEORDER 0x01020304
+
+/*
+	Flags of a binary dataSet file. Files which do not set
+	BINARYDATASETCHECKED, including those saved before the flags were
+	added, are checked for 0/1 values when they are loaded.
+*/
+#define BINARYDATASETCHECKED 1
+#define BINARYDATASETBOOLEAN 2
+
 /*
 	Structure definitions
 */
@@ -60,12 +205,28 @@ struct parameters {
 	void (*mutationType)(struct parameters *params, struct chromosome *chromo);
 	char mutationTypeName[MUTATIONTYPENAMELENGTH];
 	double (*fitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *dat);
+	double (*cutoffFitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *dat, double cutoff);
+	double (*sampleFitnessFunction)(const int numOutputs, const double *outputs, const double *targets);
 	char fitnessFunctionName[FITNESSFUNCTIONNAMELENGTH];
 	void (*selectionScheme)(struct parameters *params, struct chromosome **parents, struct chromosome **candidateChromos, int numParents, int numCandidateChromos);
 	char selectionSchemeName[SELECTIONSCHEMENAMELENGTH];
 	void (*reproductionScheme)(struct parameters *params, struct chromosome **parents, struct chromosome **children, int numParents, int numChildren);
 	char reproductionSchemeName[REPRODUCTIONSCHEMENAMELENGTH];
 	int numThreads;
+	int compileChromosomes;
+	int reuseFitness;
+	int fitnessCacheSize;
+	struct fitnessCache *fitnessCache;
+	int incrementalEvaluation;
+	int precision;
+	int screening;
+	long numScreened;
+	long numScreenedOut;
+	double screenTime;
+	double screenedOutTime;
+	double sampledScreenTime;
+	double sampledExactTime;
+	int populationEvaluation;
 };
 
 struct chromosome {
@@ -74,24 +235,31 @@ struct chromosome {
 	int numNodes;
 	int numActiveNodes;
 	int arity;
-	struct node **nodes;
+	int *nodeFunctions;
+	int *nodeInputs;
+	double *nodeWeights;
+	double *nodeValues;
+	int *nodeActive;
+	int *nodeActArity;
 	int *outputNodes;
 	int *activeNodes;
+	double (**planFunctions)(const int numInputs, const double *inputs, const double *connectionWeights);
+	int *planArity;
+	int *planOperands;
+	double *planWeights;
+	void (**planBlockFunctions)(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+	int *planColumns;
+	int *planOutputColumns;
+	int planIsFeedForward;
+	void (*compiledFunction)(const double *inputs, double *values, double *outputs);
 	double fitness;
 	double *outputValues;
 	struct functionSet *funcSet;
 	double *nodeInputsHold;
 	int generation;
-};
-
-struct node {
-	int function;
-	int *inputs;
-	double *weights;
-	int active;
-	double output;
-	int maxArity;
-	int actArity;
+	int savedEvaluations;
+	unsigned long long activeHash;
+	unsigned long long *nodeHashes;
 };
 
 struct functionSet {
@@ -99,14 +267,68 @@ struct functionSet {
 	char functionNames[FUNCTIONSETSIZE][FUNCTIONNAMELENGTH];
 	int maxNumInputs[FUNCTIONSETSIZE];
 	double (*functions[FUNCTIONSETSIZE])(const int numInputs, const double *inputs, const double *connectionWeights);
+	void (*blockFunctions[FUNCTIONSETSIZE])(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
 };
 
 struct dataSet {
 	int numSamples;
 	int numInputs;
 	int numOutputs;
+	double *inputValues;
+	double *outputValues;
 	double **inputData;
 	double **outputData;
+	double *inputColumns;
+	double *outputColumns;
+	int columnStride;
+	unsigned long long *inputBits;
+	unsigned long long *outputBits;
+	float *inputFloats;
+	void *mapping;
+	size_t mappingSize;
+	FILE *stream;
+	int streamBlockSize;
+	uint64_t streamInputsOffset;
+	uint64_t streamOutputsOffset;
+	unsigned long long streamId;
+	struct dataSetBlock *accessedBlocks;
+};
+
+/*
+	A block of consecutive samples of a streamed dataSet read into memory,
+	and an in-memory dataSet holding just those samples. The blocks read
+	through the sample accessors are owned by the dataSet, one for each
+	thread which has used them, and listed using next.
+*/
+struct dataSetBlock {
+	int block;
+	int firstSample;
+	double *values;
+	struct dataSet view;
+	const void *owner;
+	struct dataSetBlock *next;
+};
+
+/*
+	The header of a binary dataSet file, 64 bytes. It is followed by the
+	inputs and then the outputs, each sample by sample, as doubles in the
+	byte order of the machine which wrote the file. Both start at offsets
+	which are multiples of DATASETALIGNMENT. The flags record whether all
+	the values are 0 or 1, and sourceStamp identifies the size and
+	modification time of the text file a sidecar was made from, or is zero.
+*/
+struct binaryDataSetHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	int32_t numInputs;
+	int32_t numOutputs;
+	uint64_t numSamples;
+	uint64_t inputsOffset;
+	uint64_t outputsOffset;
+	uint32_t flags;
+	uint32_t reserved;
+	uint64_t sourceStamp;
 };
 
 struct results {
@@ -114,6 +336,135 @@ struct results {
 	struct chromosome **bestChromosomes;
 };
 
+/*
+	The node values of one caller executing a chromosome, so many callers
+	can execute the same chromosome at once.
+*/
+struct executionState {
+	int numInputs;
+	int numNodes;
+	int numOutputs;
+	int arity;
+	double *nodeValues;
+	double *nodeInputsHold;
+};
+
+/*
+	Least recently used cache of fitness values keyed by the canonical
+	active genotype hash. Entries are chained in hash buckets and linked
+	in order of use, most recent first. As the hash treats identical
+	subgraphs as one, each entry also holds the exact active genotype,
+	which must match for a chromosome to be given the entry's fitness.
+*/
+struct fitnessCacheEntry {
+	unsigned long long key;
+	unsigned char *genotype;
+	size_t genotypeSize;
+	double fitness;
+	int rejected;
+	int previous;
+	int next;
+	int bucketNext;
+};
+
+struct fitnessCache {
+	int capacity;
+	int numEntries;
+	int numBuckets;
+	int *buckets;
+	struct fitnessCacheEntry *entries;
+	int mostRecent;
+	int leastRecent;
+	long long lookups;
+	long long hits;
+	long genotypeBytes;
+};
+
+/*
+	A parent used as the reference for incremental evaluation, holding
+	the value of each of its active nodes for every sample in the data
+	set, one column of numSamples values per step of its execution plan.
+*/
+struct incrementalReference {
+	struct chromosome *chromo;
+	double *columns;
+	int numSamples;
+};
+
+/*
+	The arguments of evaluating the children of a generation, passed to
+	the function run by runInTeam
+*/
+struct childEvaluation {
+	struct parameters *params;
+	struct chromosome **children;
+	struct dataSet *data;
+	int *childFitnessSource;
+	struct incrementalReference *refs;
+	double cutoff;
+	unsigned long long streamSeed;
+	int inParallel;
+};
+
+/*
+	The arguments and result of supervisedLearning with the samples shared
+	between tasks, passed to the function run by runInTeam
+*/
+struct sampleEvaluation {
+	struct parameters *params;
+	struct chromosome *chromo;
+	struct dataSet *data;
+	double cutoff;
+	int useFloat;
+	double error;
+};
+
+#ifdef NATIVECOMPILATION
+
+struct compiledChromosome {
+	unsigned long long hash;
+	char *source;
+	void (*function)(const double *inputs, double *values, double *outputs);
+};
+
+struct sourceBuffer {
+	char *text;
+	int length;
+	int capacity;
+};
+
+/*
+	Compiled chromosomes shared by all threads, guarded by the
+	compiledChromosomeCache critical section.
+*/
+static struct compiledChromosome compiledChromosomeCache[COMPILEDCHROMOSOMECACHESIZE];
+static int numCompiledChromosomes = 0;
+static int nativeCompilerUnavailable = 0;
+
+#endif
+
+/*
+	State of a xoshiro256** pseudo random number generator.
+*/
+struct randomState {
+	unsigned long long s[4];
+};
+
+/*
+	Each thread draws from its own random number stream. Parallel loops
+	give each iteration a stream derived from the calling thread's stream
+	and its iteration number, so results do not depend on the number of
+	threads used.
+*/
+static struct randomState randomState = {{0x9E3779B97F4A7C15ULL, 0xBF58476D1CE4E5B9ULL, 0x94D049BB133111EBULL, 0x2545F4914F6CDD1DULL}};
+#pragma omp threadprivate(randomState)
+
+/*
+	Number of threads used to parse text dataSet files, set using
+	setDataSetParsingThreads.
+*/
+static int dataSetParsingThreads = 1;
+
 
 /*
 	Prototypes of functions used internally to CGP-Library
@@ -122,14 +473,70 @@ struct results {
 /* chromosome functions */
 static void setChromosomeActiveNodes(struct chromosome *chromo);
 static void recursivelySetActiveNodes(struct chromosome *chromo, int nodeIndex);
-static void sortChromosomeArray(struct chromosome **chromoArray, int numChromos);
-static void getBestChromosome(struct chromosome **parents, struct chromosome **children, int numParents, int numChildren, struct chromosome *best);
+static void setChromosomeExecutionPlan(struct chromosome *chromo);
+static int getExecutionPlanColumn(struct chromosome *chromo, int operand);
+static unsigned long long getActiveGenotypeHash(struct chromosome *chromo);
+static unsigned long long hashOperand(struct chromosome *chromo, unsigned long long hash, int operand);
+static int chromosomesPhenotypicallyEqual(struct chromosome *chromoA, struct chromosome *chromoB);
+static int planStepUsesWeights(struct chromosome *chromo, int step);
+static void executeChromosomeValues(struct chromosome *chromo, const double *inputs, double *nodeValues, double *inputsHold, double *outputs);
+static void executeChromosomeBlock(struct chromosome *chromo, const double **inputRows, const int numSamples, double *columns, const double **operandColumns, double *outputs);
+static void executePlanBlock(struct chromosome *chromo, const double **inputRows, const int numSamples, double *columns, const double **operandColumns, double *inputsHold, double *outputs);
+static void executePlanSamples(struct chromosome *chromo, const double **inputRows, const int numSamples, double *outputs);
+static void executePlanColumns(struct chromosome *chromo, const int numSamples, double *columns, const double **operandColumns, double *inputsHold, double *outputs);
+static void executePlanStepBlock(struct chromosome *chromo, int step, const double **operandColumns, double *inputsHold, double *nodeOutputs, const int numSamples);
+static double sanitiseNodeOutput(double nodeOutput);
+
+/* native compilation functions */
+#ifdef NATIVECOMPILATION
+static int findCompiledChromosome(unsigned long long hash, const char *source);
+static void (*compileChromosomeSource(const char *source, void **handle))(const double *inputs, double *values, double *outputs);
+static char *getChromosomeSource(struct chromosome *chromo);
+static void appendOperandSource(struct sourceBuffer *buf, struct chromosome *chromo, int step, int operand);
+static void appendSource(struct sourceBuffer *buf, const char *format, ...);
+#endif
+static void mergeSortChromosomeIndices(struct chromosome **chromoArray, int *indices, int *buffer, int numIndices);
+static void getFittestChromosomeIndices(struct chromosome **chromoArray, int numChromos, int *fittest, int numFittest);
+static int chromosomeRanksBelow(struct chromosome **chromoArray, int index, int otherIndex);
+static void siftDownFittestHeap(struct chromosome **chromoArray, int *heap, int heapSize, int position);
+static struct chromosome *getBestChromosome(struct chromosome **parents, struct chromosome **children, int numParents, int numChildren);
+static void selectFittestSlots(struct parameters *params, struct chromosome **parents, struct chromosome **children, struct chromosome **candidateChromos, int numCandidateChromos);
+static int getChildFitnessSource(struct parameters *params, struct chromosome **parents, struct chromosome **children, int *childFitnessSource, int child);
+static double getSelectionCutoff(struct parameters *params, struct chromosome **parents);
+static double getWallTime(void);
+static int canEvaluateInParallel(int numThreads);
+static int getNumTeamThreads(void);
+static void runInTeam(int numThreads, void (*function)(void *args), void *args);
+static void evaluateChildren(struct parameters *params, struct chromosome **children, struct dataSet *data, int *childFitnessSource, struct incrementalReference *refs, double cutoff, unsigned long long streamSeed, int inParallel);
+static void evaluateChildrenTasks(void *args);
+static void setChromosomeFitnessCutoff(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+static int chromosomeNeedsCompiling(struct parameters *params, struct chromosome *chromo);
+static struct chromosome *runCGPInternal(struct parameters *params, struct dataSet *data, int numGens);
+
+/* fitness cache functions */
+static struct fitnessCache *getFitnessCache(struct parameters *params);
+static void freeFitnessCache(struct fitnessCache *cache);
+static void unlinkFitnessCacheEntry(struct fitnessCache *cache, int entry);
+static void pushFitnessCacheEntry(struct fitnessCache *cache, int entry);
+static int findFitnessCacheEntry(struct fitnessCache *cache, unsigned long long key, const unsigned char *genotype, size_t genotypeSize);
+static size_t getActiveGenotype(struct chromosome *chromo, unsigned char *genotype);
+static size_t appendGenotype(unsigned char *genotype, size_t offset, const void *source, size_t numBytes);
+static int lookupFitnessCache(struct parameters *params, struct chromosome *chromo, double cutoff);
+static void insertFitnessCache(struct parameters *params, struct chromosome *chromo, double cutoff);
+static int chromosomeIsDeterministic(struct chromosome *chromo);
+static int isFitnessReused(struct parameters *params);
+static int setChromosomeFitnessCached(struct parameters *params, struct chromosome *chromo, struct dataSet *data, struct incrementalReference *refs, double cutoff);
+
+/* incremental evaluation functions */
+static int getIncrementalStepSources(struct chromosome *chromo, struct incrementalReference *ref, int *stepSource);
+static double supervisedLearningIncremental(struct parameters *params, struct chromosome *chromo, struct dataSet *data, struct incrementalReference *ref, double *fullColumns, double cutoff);
+static void setChromosomeFitnessIncremental(struct parameters *params, struct chromosome *chromo, struct dataSet *data, struct incrementalReference *refs, int numRefs, double cutoff);
+static void setIncrementalReferences(struct parameters *params, struct chromosome **parents, struct incrementalReference *refs, struct dataSet *data);
+static void freeIncrementalReference(struct incrementalReference *ref);
 static void saveChromosomeLatexRecursive(struct chromosome *chromo, int index, FILE *fp);
 
 /* node functions */
-static struct node *initialiseNode(int numInputs, int numNodes, int arity, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition);
-static void freeNode(struct node *n);
-static void copyNode(struct node *nodeDest, struct node *nodeSrc);
+static void initialiseNode(struct chromosome *chromo, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition);
 
 /* getting gene value functions  */
 static double getRandomConnectionWeight(double weightRange);
@@ -139,6 +546,7 @@ static int getRandomChromosomeOutput(int numInputs, int numNodes, int shortcutCo
 
 /* function set functions */
 static int addPresetFunctionToFunctionSet(struct parameters *params, char const *functionName);
+static void addPresetNodeFunction(struct parameters *params, double (*function)(const int numInputs, const double *inputs, const double *connectionWeights), void (*blockFunction)(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples), char const *functionName, int maxNumInputs);
 static void copyFunctionSet(struct functionSet *funcSetDest, struct functionSet *funcSetSrc);
 static void printFunctionSet(struct parameters *params);
 
@@ -159,7 +567,68 @@ static void selectFittest(struct parameters *params, struct chromosome **parents
 static void mutateRandomParent(struct parameters *params, struct chromosome **parents, struct chromosome **children, int numParents, int numChildren);
 
 /* fitness function */
-static double supervisedLearning(struct parameters *params, struct chromosome *chromo, struct dataSet *data);
+static double supervisedLearning(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+static int canSplitSampleBlocks(struct parameters *params, struct chromosome *chromo, int numSamples);
+static double addSupervisedLearningErrors(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double error, double cutoff);
+static double supervisedLearningTasks(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff, int useFloat);
+static void supervisedLearningWaves(void *args);
+static double addSampleErrors(struct parameters *params, double error, const double *outputs, double **targets, int numSamples, int numOutputs);
+
+/* Boolean evaluation functions */
+static void setDataSetBits(struct dataSet *data);
+static void setBinaryDataSetBits(struct dataSet *data, uint32_t flags);
+static int dataSetIsBoolean(struct dataSet *data);
+static void packDataSetBits(struct dataSet *data);
+static void allocateDataSet(struct dataSet *data);
+static void *mallocAligned(size_t size);
+static void freeAligned(void *ptr);
+static int isBinaryDataSetFile(char const *file);
+static int isDataSetSidecarCurrent(char const *sidecar, uint64_t sourceStamp);
+static void writeDataSetBinary(struct dataSet *data, char const *fileName, uint64_t sourceStamp);
+static char *getFileContents(char const *file, size_t *size, int *isMapped);
+static void releaseFileContents(char *contents, size_t size, int isMapped);
+static int isDataSetSeparator(char character);
+static int countDataSetLines(const char *start, const char *end);
+static int parseDataSetLines(struct dataSet *data, const char *start, const char *end, int sample, int *numValues);
+static double parseDouble(const char *token, const char *tokenEnd);
+static void readBinaryDataSetHeader(FILE *fp, char const *file, struct binaryDataSetHeader *header, long *fileSize);
+
+/* streamed dataSet functions */
+static void initialiseDataSetBlock(struct dataSet *data, struct dataSetBlock *block);
+static void freeDataSetBlock(struct dataSetBlock *block);
+static void readDataSetBlock(struct dataSet *data, int blockIndex, struct dataSetBlock *block);
+static void prefetchDataSetBlock(struct dataSet *data, int blockIndex);
+static void readDataSetFile(struct dataSet *data, void *buffer, size_t size, uint64_t offset);
+static int getNumDataSetBlocks(struct dataSet *data);
+static struct dataSetBlock *getAccessedDataSetBlock(struct dataSet *data, int sample);
+static double supervisedLearningStreamed(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+static void evaluateChildrenStreamed(struct parameters *params, struct chromosome **children, struct dataSet *data, int *childFitnessSource, double cutoff, unsigned long long streamSeed, int inParallel);
+static void evaluateChildrenStreamedTasks(void *args);
+static void evaluateChildrenBatched(struct parameters *params, struct chromosome **children, struct dataSet *data, int *childFitnessSource, double cutoff, unsigned long long streamSeed, int inParallel);
+static void evaluateChildrenBatchedTasks(void *args);
+static void executeChildrenSamples(struct chromosome **children, const int *childIndices, const int *useFloat, int numChildren, struct dataSet *data, int sampleStart, int numSamples, double *outputs, size_t childStride);
+static int functionIsBoolean(double (*function)(const int numInputs, const double *inputs, const double *connectionWeights));
+static int functionSetIsBoolean(struct parameters *params);
+static int chromosomeIsBoolean(struct chromosome *chromo);
+static double supervisedLearningBoolean(struct chromosome *chromo, struct dataSet *data, double cutoff);
+static const unsigned long long *getBooleanColumn(struct chromosome *chromo, struct dataSet *data, unsigned long long *nodeWords, int column, int wordStart);
+static void executePlanStepBoolean(struct chromosome *chromo, int step, const unsigned long long **operandWords, unsigned long long *nodeWords, const int numWords);
+static int countBits(unsigned long long bits);
+
+/* single precision evaluation functions */
+static void setDataSetFloats(struct dataSet *data);
+static int chromosomeHasFloatFunctions(struct chromosome *chromo);
+static double supervisedLearningFloat(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+static void executePlanBlockFloat(struct chromosome *chromo, struct dataSet *data, int sampleStart, int numSamples, float *columns, const float **operandColumns, float *weights, double *outputs);
+static void executePlanSamplesFloat(struct chromosome *chromo, struct dataSet *data, int sampleStart, int numSamples, double *outputs);
+static void executePlanStepFloat(struct chromosome *chromo, int step, const float **operandColumns, const float *weights, float *nodeOutputs, const int numSamples);
+static float sanitiseNodeOutputFloat(float nodeOutput);
+
+/* screening functions */
+static int canScreenChromosome(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+static int screenChromosome(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+static void addScreeningStatistics(struct parameters *params, int screenedOut, double screenTime, double exactTime);
+static void resetScreeningStatistics(struct parameters *params);
 
 /* node functions defines in CGP-Library */
 static double _add(const int numInputs, const double *inputs, const double *connectionWeights);
@@ -193,11 +662,47 @@ static double _step(const int numInputs, const double *inputs, const double *con
 static double _softsign(const int numInputs, const double *inputs, const double *connectionWeights);
 static double _hyperbolicTangent(const int numInputs, const double *inputs, const double *connectionWeights);
 
+/* sample block node functions */
+static void _addBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _subBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _mulBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _divideBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _absoluteBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _squareRootBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _squareBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _cubeBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _powerBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _exponentialBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _sineBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _cosineBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _tangentBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _constOneBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _constZeroBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _constPIBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _andBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _nandBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _orBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _norBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _xorBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _xnorBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _notBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _wireBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _sigmoidBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _gaussianBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _stepBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _softsignBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void _hyperbolicTangentBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+static void sumWeigtedInputsBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples);
+
 /* other */
 static double randDecimal(void);
 static int randInt(int n);
+static unsigned long long nextRandom(struct randomState *state);
+static unsigned long long mixRandomBits(unsigned long long bits);
+static void seedRandomState(struct randomState *state, unsigned long long seed, unsigned long long stream);
 static double sumWeigtedInputs(const int numInputs, const double *inputs, const double *connectionWeights);
 static void sortIntArray(int *array, const int length);
+static unsigned long long hashBytes(unsigned long long hash, const void *data, size_t numBytes);
 static void sortDoubleArray(double *array, const int length);
 static int cmpInt(const void * a, const void * b);
 static int cmpDouble(const void * a, const void * b);
@@ -244,7 +749,9 @@ DLL_EXPORT struct parameters *initialiseParameters(const int numInputs, const in
 	params->funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
 	params->funcSet->numFunctions = 0;
 
-	params->fitnessFunction = supervisedLearning;
+	params->fitnessFunction = NULL;
+	params->cutoffFitnessFunction = supervisedLearning;
+	params->sampleFitnessFunction = NULL;
 	strncpy(params->fitnessFunctionName, "supervisedLearning", FITNESSFUNCTIONNAMELENGTH);
 
 	params->selectionScheme = selectFittest;
@@ -254,9 +761,18 @@ DLL_EXPORT struct parameters *initialiseParameters(const int numInputs, const in
 	strncpy(params->reproductionSchemeName, "mutateRandomParent", REPRODUCTIONSCHEMENAMELENGTH);
 
 	params->numThreads = 1;
+	params->compileChromosomes = 0;
+	params->reuseFitness = -1;
+	params->fitnessCacheSize = FITNESSCACHESIZE;
+	params->fitnessCache = NULL;
+	params->incrementalEvaluation = 0;
+	params->precision = 64;
+	params->screening = 0;
+	resetScreeningStatistics(params);
+	params->populationEvaluation = 0;
 
 	/* Seed the random number generator */
-	srand(time(NULL));
+	setRandomNumberSeed((unsigned int)time(NULL));
 
 	return params;
 }
@@ -273,6 +789,7 @@ DLL_EXPORT void freeParameters(struct parameters *params) {
 		return;
 	}
 
+	freeFitnessCache(params->fitnessCache);
 	free(params->funcSet);
 	free(params);
 }
@@ -305,7 +822,14 @@ DLL_EXPORT void printParameters(struct parameters *params) {
 	printf("Selection scheme:\t\t\t%s\n", params->selectionSchemeName);
 	printf("Reproduction scheme:\t\t\t%s\n", params->reproductionSchemeName);
 	printf("Update frequency:\t\t\t%d\n", params->updateFrequency);
-	printf("Threads:\t\t\t%d\n", params->numThreads);
+	printf("Threads:\t\t\t\t%d\n", params->numThreads);
+	printf("Compile Chromosomes:\t\t\t%d\n", params->compileChromosomes);
+	printf("Reuse Fitness:\t\t\t\t%d\n", isFitnessReused(params));
+	printf("Fitness Cache Size:\t\t\t%d\n", params->fitnessCacheSize);
+	printf("Incremental Evaluation:\t\t\t%d\n", params->incrementalEvaluation);
+	printf("Precision:\t\t\t\t%s\n", params->precision == 32 ? "float" : "double");
+	printf("Screening:\t\t\t\t%d\n", params->screening);
+	printf("Population Evaluation:\t\t\t%d\n", params->populationEvaluation);
 	printFunctionSet(params);
 	printf("-----------------------------------------------------------\n\n");
 }
@@ -364,6 +888,9 @@ DLL_EXPORT void addCustomNodeFunction(struct parameters *params, double (*functi
 	/* add the given function to the function set */
 	params->funcSet->functions[params->funcSet->numFunctions] = function;
 
+	/* custom functions do not have a sample block variant */
+	params->funcSet->blockFunctions[params->funcSet->numFunctions] = NULL;
+
 	params->funcSet->numFunctions++;
 }
 
@@ -379,104 +906,104 @@ static int addPresetFunctionToFunctionSet(struct parameters *params, char const
 	/* Symbolic functions */
 
 	if (strncmp(functionName, "add", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _add, "add", -1);
+		addPresetNodeFunction(params, _add, _addBlock, "add", -1);
 	}
 	else if (strncmp(functionName, "sub", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _sub, "sub", -1);
+		addPresetNodeFunction(params, _sub, _subBlock, "sub", -1);
 	}
 	else if (strncmp(functionName, "mul", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _mul, "mul", -1);
+		addPresetNodeFunction(params, _mul, _mulBlock, "mul", -1);
 	}
 	else if (strncmp(functionName, "div", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _divide, "div", -1);
+		addPresetNodeFunction(params, _divide, _divideBlock, "div", -1);
 	}
 	else if (strncmp(functionName, "abs", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _absolute, "abs", 1);
+		addPresetNodeFunction(params, _absolute, _absoluteBlock, "abs", 1);
 	}
 	else if (strncmp(functionName, "sqrt", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _squareRoot, "sqrt", 1);
+		addPresetNodeFunction(params, _squareRoot, _squareRootBlock, "sqrt", 1);
 	}
 	else if (strncmp(functionName, "sq", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _square, "sq", 1);
+		addPresetNodeFunction(params, _square, _squareBlock, "sq", 1);
 	}
 	else if (strncmp(functionName, "cube", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _cube, "cube", 1);
+		addPresetNodeFunction(params, _cube, _cubeBlock, "cube", 1);
 	}
 	else if (strncmp(functionName, "pow", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _power, "pow", 2);
+		addPresetNodeFunction(params, _power, _powerBlock, "pow", 2);
 	}
 	else if (strncmp(functionName, "exp", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _exponential, "exp", 1);
+		addPresetNodeFunction(params, _exponential, _exponentialBlock, "exp", 1);
 	}
 	else if (strncmp(functionName, "sin", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _sine, "sin", 1);
+		addPresetNodeFunction(params, _sine, _sineBlock, "sin", 1);
 	}
 	else if (strncmp(functionName, "cos", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _cosine, "cos", 1);
+		addPresetNodeFunction(params, _cosine, _cosineBlock, "cos", 1);
 	}
 	else if (strncmp(functionName, "tan", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _tangent, "tan", 1);
+		addPresetNodeFunction(params, _tangent, _tangentBlock, "tan", 1);
 	}
 
 
 	/* Boolean logic gates */
 
 	else if (strncmp(functionName, "and", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _and, "and", -1);
+		addPresetNodeFunction(params, _and, _andBlock, "and", -1);
 	}
 	else if (strncmp(functionName, "nand", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _nand, "nand", -1);
+		addPresetNodeFunction(params, _nand, _nandBlock, "nand", -1);
 	}
 	else if (strncmp(functionName, "or", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _or, "or", -1);
+		addPresetNodeFunction(params, _or, _orBlock, "or", -1);
 	}
 	else if (strncmp(functionName, "nor", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _nor, "nor", -1);
+		addPresetNodeFunction(params, _nor, _norBlock, "nor", -1);
 	}
 	else if (strncmp(functionName, "xor", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _xor, "xor", -1);
+		addPresetNodeFunction(params, _xor, _xorBlock, "xor", -1);
 	}
 	else if (strncmp(functionName, "xnor", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _xnor, "xnor", -1);
+		addPresetNodeFunction(params, _xnor, _xnorBlock, "xnor", -1);
 	}
 	else if (strncmp(functionName, "not", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _not, "not", 1);
+		addPresetNodeFunction(params, _not, _notBlock, "not", 1);
 	}
 
 	/* Neuron functions */
 
 	else if (strncmp(functionName, "sig", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _sigmoid, "sig", -1);
+		addPresetNodeFunction(params, _sigmoid, _sigmoidBlock, "sig", -1);
 	}
 	else if (strncmp(functionName, "gauss", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _gaussian, "gauss", -1);
+		addPresetNodeFunction(params, _gaussian, _gaussianBlock, "gauss", -1);
 	}
 	else if (strncmp(functionName, "step", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _step, "step", -1);
+		addPresetNodeFunction(params, _step, _stepBlock, "step", -1);
 	}
 	else if (strncmp(functionName, "softsign", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _softsign, "soft", -1);
+		addPresetNodeFunction(params, _softsign, _softsignBlock, "soft", -1);
 	}
 	else if (strncmp(functionName, "tanh", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _hyperbolicTangent, "tanh", -1);
+		addPresetNodeFunction(params, _hyperbolicTangent, _hyperbolicTangentBlock, "tanh", -1);
 	}
 
 	/* other */
 
 	else if (strncmp(functionName, "rand", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _randFloat, "rand", 0);
+		addPresetNodeFunction(params, _randFloat, NULL, "rand", 0);
 	}
 	else if (strncmp(functionName, "1", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _constOne, "1", 0);
+		addPresetNodeFunction(params, _constOne, _constOneBlock, "1", 0);
 	}
 	else if (strncmp(functionName, "0", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _constZero, "0", 0);
+		addPresetNodeFunction(params, _constZero, _constZeroBlock, "0", 0);
 	}
 	else if (strncmp(functionName, "pi", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _constPI, "pi", 0);
+		addPresetNodeFunction(params, _constPI, _constPIBlock, "pi", 0);
 	}
 	else if (strncmp(functionName, "wire", FUNCTIONNAMELENGTH) == 0) {
-		addCustomNodeFunction(params, _wire, "wire", 1);
+		addPresetNodeFunction(params, _wire, _wireBlock, "wire", 1);
 	}
 
 	else {
@@ -488,6 +1015,23 @@ static int addPresetFunctionToFunctionSet(struct parameters *params, char const
 }
 
 
+/*
+	Adds the given preset node function and its sample block variant
+	to the function set.
+*/
+static void addPresetNodeFunction(struct parameters *params, double (*function)(const int numInputs, const double *inputs, const double *connectionWeights), void (*blockFunction)(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples), char const *functionName, int maxNumInputs) {
+
+	int functionIndex = params->funcSet->numFunctions;
+
+	addCustomNodeFunction(params, function, functionName, maxNumInputs);
+
+	/* only if the function was added */
+	if (params->funcSet->numFunctions > functionIndex) {
+		params->funcSet->blockFunctions[functionIndex] = blockFunction;
+	}
+}
+
+
 /*
 	clears the given function set of functions
 */
@@ -664,14 +1208,71 @@ DLL_EXPORT void setConnectionWeightRange(struct parameters *params, double weigh
 */
 DLL_EXPORT void setCustomFitnessFunction(struct parameters *params, double (*fitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data), char const *fitnessFunctionName) {
 
+	params->sampleFitnessFunction = NULL;
+
 	if (fitnessFunction == NULL) {
-		params->fitnessFunction = supervisedLearning;
+		params->fitnessFunction = NULL;
+		params->cutoffFitnessFunction = supervisedLearning;
 		strncpy(params->fitnessFunctionName, "supervisedLearning", FITNESSFUNCTIONNAMELENGTH);
 	}
 	else {
 		params->fitnessFunction = fitnessFunction;
+		params->cutoffFitnessFunction = NULL;
 		strncpy(params->fitnessFunctionName, fitnessFunctionName, FITNESSFUNCTIONNAMELENGTH);
 	}
+
+	/* cached fitness values were assigned by the previous fitness function */
+	clearFitnessCache(params);
+}
+
+
+/*
+	sets the fitness function to the given fitness function which also takes
+	the cutoff above which the chromosome is rejected. If the fitnessFunction
+	is NULL then the default supervisedLearning fitness function is used.
+*/
+DLL_EXPORT void setCustomFitnessFunctionWithCutoff(struct parameters *params, double (*fitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff), char const *fitnessFunctionName) {
+
+	params->fitnessFunction = NULL;
+	params->sampleFitnessFunction = NULL;
+
+	if (fitnessFunction == NULL) {
+		params->cutoffFitnessFunction = supervisedLearning;
+		strncpy(params->fitnessFunctionName, "supervisedLearning", FITNESSFUNCTIONNAMELENGTH);
+	}
+	else {
+		params->cutoffFitnessFunction = fitnessFunction;
+		strncpy(params->fitnessFunctionName, fitnessFunctionName, FITNESSFUNCTIONNAMELENGTH - 1);
+		params->fitnessFunctionName[FITNESSFUNCTIONNAMELENGTH - 1] = '\0';
+	}
+
+	/* cached fitness values were assigned by the previous fitness function */
+	clearFitnessCache(params);
+}
+
+
+/*
+	sets the fitness function to supervisedLearning summing the given sample
+	fitness function over the samples, in sample order, rather than the
+	absolute errors. If the sampleFitnessFunction is NULL then the default
+	supervisedLearning fitness function is used.
+*/
+DLL_EXPORT void setCustomSampleFitnessFunction(struct parameters *params, double (*sampleFitnessFunction)(const int numOutputs, const double *outputs, const double *targets), char const *fitnessFunctionName) {
+
+	params->fitnessFunction = NULL;
+	params->cutoffFitnessFunction = supervisedLearning;
+	params->sampleFitnessFunction = sampleFitnessFunction;
+
+	if (sampleFitnessFunction == NULL) {
+		strncpy(params->fitnessFunctionName, "supervisedLearning", FITNESSFUNCTIONNAMELENGTH);
+	}
+	else {
+		strncpy(params->fitnessFunctionName, fitnessFunctionName, FITNESSFUNCTIONNAMELENGTH - 1);
+		params->fitnessFunctionName[FITNESSFUNCTIONNAMELENGTH - 1] = '\0';
+	}
+
+	/* cached fitness values were assigned by the previous fitness function */
+	clearFitnessCache(params);
 }
 
 
@@ -792,94 +1393,333 @@ DLL_EXPORT void setNumThreads(struct parameters *params, int numThreads) {
 
 
 /*
-	chromosome function definitions
+	sets whether chromosomes are compiled to native code before being assigned a fitness
 */
+DLL_EXPORT void setCompileChromosomes(struct parameters *params, int compileChromosomes) {
+
+	/* error checking */
+	if (compileChromosomes != 0 && compileChromosomes != 1) {
+		printf("Warning: compile chromosomes must be 0 or 1; %d is invalid. Compile chromosomes is left unchanged as %d.\n", compileChromosomes, params->compileChromosomes);
+		return;
+	}
+
+	params->compileChromosomes = compileChromosomes;
+}
 
 
 /*
-	Returns a pointer to an initialised chromosome with values obeying the given parameters.
+	sets whether runCGP reuses the fitness of children whose active genotype matches an already evaluated chromosome
 */
-DLL_EXPORT struct chromosome *initialiseChromosome(struct parameters *params) {
+DLL_EXPORT void setReuseFitness(struct parameters *params, int reuseFitness) {
 
-	struct chromosome *chromo;
-	int i;
+	/* error checking */
+	if (reuseFitness != 0 && reuseFitness != 1) {
+		printf("Warning: reuse fitness must be 0 or 1; %d is invalid. Reuse fitness is left unchanged as %d.\n", reuseFitness, isFitnessReused(params));
+		return;
+	}
 
-	/* check that funcSet contains functions */
-	if (params->funcSet->numFunctions < 1) {
-		printf("Error: chromosome not initialised due to empty functionSet.\nTerminating CGP-Library.\n");
-		exit(0);
+	params->reuseFitness = reuseFitness;
+}
+
+
+/*
+	sets the maximum number of fitness values kept by the fitness cache, zero turns the cache off
+*/
+DLL_EXPORT void setFitnessCacheSize(struct parameters *params, int fitnessCacheSize) {
+
+	/* error checking */
+	if (fitnessCacheSize < 0) {
+		printf("Warning: fitness cache size of %d is invalid. The fitness cache size must be >= 0. The fitness cache size is left unchanged as %d.\n", fitnessCacheSize, params->fitnessCacheSize);
+		return;
 	}
 
-	/* allocate memory for chromosome */
-	chromo = (struct chromosome*)malloc(sizeof(struct chromosome));
+	params->fitnessCacheSize = fitnessCacheSize;
 
-	/* allocate memory for nodes */
-	chromo->nodes = (struct node**)malloc(params->numNodes * sizeof(struct node*));
+	/* the cache is recreated at the new size when next used */
+	clearFitnessCache(params);
+}
 
-	/* allocate memory for outputNodes matrix */
-	chromo->outputNodes = (int*)malloc(params->numOutputs * sizeof(int));
 
-	/* allocate memory for active nodes matrix */
-	chromo->activeNodes = (int*)malloc(params->numNodes * sizeof(int));
+/*
+	sets whether runCGP evaluates children incrementally from their parents
+*/
+DLL_EXPORT void setIncrementalEvaluation(struct parameters *params, int incrementalEvaluation) {
 
-	/* allocate memory for chromosome outputValues */
-	chromo->outputValues = (double*)malloc(params->numOutputs * sizeof(double));
+	/* error checking */
+	if (incrementalEvaluation != 0 && incrementalEvaluation != 1) {
+		printf("Warning: incremental evaluation must be 0 or 1; %d is invalid. Incremental evaluation is left unchanged as %d.\n", incrementalEvaluation, params->incrementalEvaluation);
+		return;
+	}
 
-	/* Initialise each of the chromosomes nodes */
-	for (i = 0; i < params->numNodes; i++) {
-		chromo->nodes[i] = initialiseNode(params->numInputs, params->numNodes, params->arity, params->funcSet->numFunctions, params->connectionWeightRange, params->recurrentConnectionProbability, i);
+	params->incrementalEvaluation = incrementalEvaluation;
+}
+
+
+/*
+	Sets the precision the default fitness function executes chromosomes
+	in, "double" or "float"
+*/
+DLL_EXPORT void setPrecision(struct parameters *params, char const *precision) {
+
+	int newPrecision;
+
+	if (strcmp(precision, "double") == 0) {
+		newPrecision = 64;
+	}
+	else if (strcmp(precision, "float") == 0) {
+		newPrecision = 32;
+	}
+	else {
+		printf("\nWarning: precision '%s' is invalid. The precision must be 'double' or 'float'. The precision has been left unchanged as '%s'.\n", precision, params->precision == 32 ? "float" : "double");
+		return;
 	}
 
-	/* set each of the chromosomes outputs */
-	for (i = 0; i < params->numOutputs; i++) {
-		chromo->outputNodes[i] = getRandomChromosomeOutput(params->numInputs, params->numNodes, params->shortcutConnections);
+	/* cached fitness values were found at the previous precision */
+	if (newPrecision != params->precision) {
+		params->precision = newPrecision;
+		clearFitnessCache(params);
 	}
+}
 
-	/* set the number of inputs, nodes and outputs */
-	chromo->numInputs = params->numInputs;
-	chromo->numNodes = params->numNodes;
-	chromo->numOutputs = params->numOutputs;
-	chromo->arity = params->arity;
 
-	/* set the number of active node to the number of nodes (all active) */
-	chromo->numActiveNodes = params->numNodes;
+/*
+	sets whether runCGP screens children in single precision before
+	evaluating them in double precision
+*/
+DLL_EXPORT void setScreening(struct parameters *params, int screening) {
 
-	/* set the fitness to initial value */
-	chromo->fitness = -1;
+	/* error checking */
+	if (screening != 0 && screening != 1) {
+		printf("Warning: screening must be 0 or 1; %d is invalid. Screening is left unchanged as %d.\n", screening, params->screening);
+		return;
+	}
 
-	/* copy the function set from the parameters to the chromosome */
-	chromo->funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
-	copyFunctionSet(chromo->funcSet, params->funcSet);
+	params->screening = screening;
+}
 
-	/* set the active nodes in the newly generated chromosome */
-	setChromosomeActiveNodes(chromo);
 
-	/* used interally when exicuting chromosome */
-	chromo->nodeInputsHold = (double*)malloc(params->arity * sizeof(double));
+/*
+	sets whether runCGP evaluates all of the children on each block of
+	samples in turn rather than each child on every sample in turn
+*/
+DLL_EXPORT void setPopulationEvaluation(struct parameters *params, int populationEvaluation) {
 
-	return chromo;
+	/* error checking */
+	if (populationEvaluation != 0 && populationEvaluation != 1) {
+		printf("Warning: population evaluation must be 0 or 1; %d is invalid. Population evaluation is left unchanged as %d.\n", populationEvaluation, params->populationEvaluation);
+		return;
+	}
+
+	params->populationEvaluation = populationEvaluation;
 }
 
 
 /*
-	Reads in saved chromosomes
+	returns the fraction of the children screened in single precision which
+	were rejected without being evaluated in double precision
 */
-DLL_EXPORT struct chromosome* initialiseChromosomeFromFile(char const *file) {
-
-	int i, j;
+DLL_EXPORT double getScreenedOutFraction(struct parameters *params) {
 
-	FILE *fp;
-	struct chromosome *chromo;
-	struct parameters *params;
+	double fraction = 0;
 
-	char *line, *record;
-	char funcName[FUNCTIONNAMELENGTH];
-	char buffer[1024];
+	#pragma omp critical (screening)
+	{
+		if (params->numScreened > 0) {
+			fraction = (double)params->numScreenedOut / (double)params->numScreened;
+		}
+	}
 
-	int numInputs, numNodes, numOutputs, arity;
+	return fraction;
+}
 
-	/* open the chromosome file */
-	fp = fopen(file, "r");
+
+/*
+	returns an estimate of the evaluation time in seconds saved by screening,
+	summed over all threads. The double precision evaluations avoided are
+	estimated from the time the screened out children took to screen, scaled
+	by the ratio of double precision to screening time of the sample of them
+	also evaluated in double precision; the time spent screening and
+	evaluating the sample is then subtracted.
+*/
+DLL_EXPORT double getScreeningTimeSaved(struct parameters *params) {
+
+	double timeSaved = 0;
+
+	#pragma omp critical (screening)
+	{
+		if (params->sampledScreenTime > 0) {
+			timeSaved = params->screenedOutTime * (params->sampledExactTime / params->sampledScreenTime);
+			timeSaved -= params->screenTime + params->sampledExactTime;
+		}
+	}
+
+	return timeSaved;
+}
+
+
+/*
+	empties the fitness cache and resets its statistics
+*/
+DLL_EXPORT void clearFitnessCache(struct parameters *params) {
+
+	#pragma omp critical (fitnessCache)
+	{
+		freeFitnessCache(params->fitnessCache);
+		params->fitnessCache = NULL;
+	}
+}
+
+
+/*
+	returns the fraction of fitness cache lookups which found a fitness
+*/
+DLL_EXPORT double getFitnessCacheHitRate(struct parameters *params) {
+
+	double hitRate = 0;
+
+	#pragma omp critical (fitnessCache)
+	{
+		if (params->fitnessCache != NULL && params->fitnessCache->lookups > 0) {
+			hitRate = (double)params->fitnessCache->hits / (double)params->fitnessCache->lookups;
+		}
+	}
+
+	return hitRate;
+}
+
+
+/*
+	returns the number of bytes of memory used by the fitness cache
+*/
+DLL_EXPORT long getFitnessCacheMemoryUsage(struct parameters *params) {
+
+	long memoryUsage = 0;
+
+	#pragma omp critical (fitnessCache)
+	{
+		if (params->fitnessCache != NULL) {
+			memoryUsage = sizeof(struct fitnessCache);
+			memoryUsage += params->fitnessCache->numBuckets * sizeof(int);
+			memoryUsage += params->fitnessCache->capacity * sizeof(struct fitnessCacheEntry);
+			memoryUsage += params->fitnessCache->genotypeBytes;
+		}
+	}
+
+	return memoryUsage;
+}
+
+
+/*
+	chromosome function definitions
+*/
+
+
+/*
+	Returns a pointer to an initialised chromosome with values obeying the given parameters.
+*/
+DLL_EXPORT struct chromosome *initialiseChromosome(struct parameters *params) {
+
+	struct chromosome *chromo;
+	int i;
+
+	/* check that funcSet contains functions */
+	if (params->funcSet->numFunctions < 1) {
+		printf("Error: chromosome not initialised due to empty functionSet.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* allocate memory for chromosome */
+	chromo = (struct chromosome*)malloc(sizeof(struct chromosome));
+
+	/* set the number of inputs, nodes and outputs */
+	chromo->numInputs = params->numInputs;
+	chromo->numNodes = params->numNodes;
+	chromo->numOutputs = params->numOutputs;
+	chromo->arity = params->arity;
+
+	/* allocate memory for the node genes, each gene type is stored contiguously for all nodes */
+	chromo->nodeFunctions = (int*)malloc(params->numNodes * sizeof(int));
+	chromo->nodeInputs = (int*)malloc(params->numNodes * params->arity * sizeof(int));
+	chromo->nodeWeights = (double*)malloc(params->numNodes * params->arity * sizeof(double));
+
+	/* allocate memory for the chromosome input and node output values, which share one index space */
+	chromo->nodeValues = (double*)malloc((params->numInputs + params->numNodes) * sizeof(double));
+
+	/* allocate memory for the node active flags and actual arities */
+	chromo->nodeActive = (int*)malloc(params->numNodes * sizeof(int));
+	chromo->nodeActArity = (int*)malloc(params->numNodes * sizeof(int));
+	chromo->nodeHashes = (unsigned long long*)malloc(params->numNodes * sizeof(unsigned long long));
+
+	/* allocate memory for outputNodes matrix */
+	chromo->outputNodes = (int*)malloc(params->numOutputs * sizeof(int));
+
+	/* allocate memory for active nodes matrix */
+	chromo->activeNodes = (int*)malloc(params->numNodes * sizeof(int));
+
+	/* allocate memory for the execution plan */
+	chromo->planFunctions = malloc(params->numNodes * sizeof(*chromo->planFunctions));
+	chromo->planArity = (int*)malloc(params->numNodes * sizeof(int));
+	chromo->planOperands = (int*)malloc(params->numNodes * params->arity * sizeof(int));
+	chromo->planWeights = (double*)malloc(params->numNodes * params->arity * sizeof(double));
+	chromo->planBlockFunctions = malloc(params->numNodes * sizeof(*chromo->planBlockFunctions));
+	chromo->planColumns = (int*)malloc(params->numNodes * params->arity * sizeof(int));
+	chromo->planOutputColumns = (int*)malloc(params->numOutputs * sizeof(int));
+
+	/* allocate memory for chromosome outputValues */
+	chromo->outputValues = (double*)malloc(params->numOutputs * sizeof(double));
+
+	/* Initialise each of the chromosomes nodes */
+	for (i = 0; i < params->numNodes; i++) {
+		initialiseNode(chromo, params->funcSet->numFunctions, params->connectionWeightRange, params->recurrentConnectionProbability, i);
+	}
+
+	/* set each of the chromosomes outputs */
+	for (i = 0; i < params->numOutputs; i++) {
+		chromo->outputNodes[i] = getRandomChromosomeOutput(params->numInputs, params->numNodes, params->shortcutConnections);
+	}
+
+	/* set the number of active node to the number of nodes (all active) */
+	chromo->numActiveNodes = params->numNodes;
+
+	/* set the fitness to initial value */
+	chromo->fitness = -1;
+
+	/* no evaluations have been saved */
+	chromo->savedEvaluations = 0;
+
+	/* copy the function set from the parameters to the chromosome */
+	chromo->funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
+	copyFunctionSet(chromo->funcSet, params->funcSet);
+
+	/* set the active nodes in the newly generated chromosome */
+	setChromosomeActiveNodes(chromo);
+
+	/* used interally when exicuting chromosome */
+	chromo->nodeInputsHold = (double*)malloc(params->arity * sizeof(double));
+
+	return chromo;
+}
+
+
+/*
+	Reads in saved chromosomes
+*/
+DLL_EXPORT struct chromosome* initialiseChromosomeFromFile(char const *file) {
+
+	int i, j;
+
+	FILE *fp;
+	struct chromosome *chromo;
+	struct parameters *params;
+
+	char *line, *record;
+	char funcName[FUNCTIONNAMELENGTH];
+	char buffer[1024];
+
+	int numInputs, numNodes, numOutputs, arity;
+
+	/* open the chromosome file */
+	fp = fopen(file, "r");
 
 	/* ensure that the file was opened correctly */
 	if (fp == NULL) {
@@ -949,11 +1789,11 @@ DLL_EXPORT struct chromosome* initialiseChromosomeFromFile(char const *file) {
 		/* get the function gene */
 		line = fgets(buffer, sizeof(buffer), fp);
 		record = strtok(line, ",\n");
-		chromo->nodes[i]->function = atoi(record);
+		chromo->nodeFunctions[i] = atoi(record);
 
 		for (j = 0; j < arity; j++) {
 			line = fgets(buffer, sizeof(buffer), fp);
-			sscanf(line, "%d,%lf", &chromo->nodes[i]->inputs[j], &chromo->nodes[i]->weights[j]);
+			sscanf(line, "%d,%lf", &chromo->nodeInputs[(i * arity) + j], &chromo->nodeWeights[(i * arity) + j]);
 		}
 	}
 
@@ -983,7 +1823,6 @@ DLL_EXPORT struct chromosome* initialiseChromosomeFromFile(char const *file) {
 DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromosome *chromo) {
 
 	struct chromosome *chromoNew;
-	int i;
 
 	/* check that funcSet contains functions*/
 	if (chromo == NULL) {
@@ -994,8 +1833,24 @@ DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromoso
 	/* allocate memory for chromosome */
 	chromoNew = (struct chromosome*)malloc(sizeof(struct chromosome));
 
-	/* allocate memory for nodes */
-	chromoNew->nodes = (struct node**)malloc(chromo->numNodes * sizeof(struct node*));
+	/* set the number of inputs, nodes and outputs */
+	chromoNew->numInputs = chromo->numInputs;
+	chromoNew->numNodes = chromo->numNodes;
+	chromoNew->numOutputs = chromo->numOutputs;
+	chromoNew->arity = chromo->arity;
+
+	/* allocate memory for the node genes */
+	chromoNew->nodeFunctions = (int*)malloc(chromo->numNodes * sizeof(int));
+	chromoNew->nodeInputs = (int*)malloc(chromo->numNodes * chromo->arity * sizeof(int));
+	chromoNew->nodeWeights = (double*)malloc(chromo->numNodes * chromo->arity * sizeof(double));
+
+	/* allocate memory for the chromosome input and node output values */
+	chromoNew->nodeValues = (double*)malloc((chromo->numInputs + chromo->numNodes) * sizeof(double));
+
+	/* allocate memory for the node active flags and actual arities */
+	chromoNew->nodeActive = (int*)malloc(chromo->numNodes * sizeof(int));
+	chromoNew->nodeActArity = (int*)malloc(chromo->numNodes * sizeof(int));
+	chromoNew->nodeHashes = (unsigned long long*)malloc(chromo->numNodes * sizeof(unsigned long long));
 
 	/* allocate memory for outputNodes matrix */
 	chromoNew->outputNodes = (int*)malloc(chromo->numOutputs * sizeof(int));
@@ -1003,32 +1858,33 @@ DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromoso
 	/* allocate memory for active nodes matrix */
 	chromoNew->activeNodes = (int*)malloc(chromo->numNodes * sizeof(int));
 
+	/* allocate memory for the execution plan */
+	chromoNew->planFunctions = malloc(chromo->numNodes * sizeof(*chromoNew->planFunctions));
+	chromoNew->planArity = (int*)malloc(chromo->numNodes * sizeof(int));
+	chromoNew->planOperands = (int*)malloc(chromo->numNodes * chromo->arity * sizeof(int));
+	chromoNew->planWeights = (double*)malloc(chromo->numNodes * chromo->arity * sizeof(double));
+	chromoNew->planBlockFunctions = malloc(chromo->numNodes * sizeof(*chromoNew->planBlockFunctions));
+	chromoNew->planColumns = (int*)malloc(chromo->numNodes * chromo->arity * sizeof(int));
+	chromoNew->planOutputColumns = (int*)malloc(chromo->numOutputs * sizeof(int));
+
 	/* allocate memory for chromosome outputValues */
 	chromoNew->outputValues = (double*)malloc(chromo->numOutputs * sizeof(double));
 
-	/* Initialise each of the chromosomes nodes */
-	for (i = 0; i < chromo->numNodes; i++) {
-		chromoNew->nodes[i] = initialiseNode(chromo->numInputs, chromo->numNodes, chromo->arity, chromo->funcSet->numFunctions, 0, 0, i);
-		copyNode(chromoNew->nodes[i], chromo->nodes[i]);
-	}
+	/* copy the node genes and outputs as bulk copies */
+	memcpy(chromoNew->nodeFunctions, chromo->nodeFunctions, chromo->numNodes * sizeof(int));
+	memcpy(chromoNew->nodeInputs, chromo->nodeInputs, chromo->numNodes * chromo->arity * sizeof(int));
+	memcpy(chromoNew->nodeWeights, chromo->nodeWeights, chromo->numNodes * chromo->arity * sizeof(double));
+	memset(chromoNew->nodeValues, 0, (chromo->numInputs + chromo->numNodes) * sizeof(double));
 
 	/* set each of the chromosomes outputs */
-	for (i = 0; i < chromo->numOutputs; i++) {
-		chromoNew->outputNodes[i] = chromo->outputNodes[i];
-	}
-
-	/* set the number of inputs, nodes and outputs */
-	chromoNew->numInputs = chromo->numInputs;
-	chromoNew->numNodes = chromo->numNodes;
-	chromoNew->numOutputs = chromo->numOutputs;
-	chromoNew->arity = chromo->arity;
-
+	memcpy(chromoNew->outputNodes, chromo->outputNodes, chromo->numOutputs * sizeof(int));
 
 	/* copy over the chromsosme fitness */
 	chromoNew->fitness = chromo->fitness;
 
 	/* copy over the number of gnerations to find a solution */
 	chromoNew->generation = chromo->generation;
+	chromoNew->savedEvaluations = chromo->savedEvaluations;
 
 	/* copy over the functionset */
 	chromoNew->funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
@@ -1049,24 +1905,31 @@ DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromoso
 */
 DLL_EXPORT void freeChromosome(struct chromosome *chromo) {
 
-	int i;
-
 	/* attempt to prevent user double freeing */
 	if (chromo == NULL) {
 		printf("Warning: double freeing of chromosome prevented.\n");
 		return;
 	}
 
-	for (i = 0; i < chromo->numNodes; i++) {
-		freeNode(chromo->nodes[i]);
-	}
-
 	free(chromo->nodeInputsHold);
 	free(chromo->funcSet);
 	free(chromo->outputValues);
-	free(chromo->nodes);
+	free(chromo->nodeFunctions);
+	free(chromo->nodeInputs);
+	free(chromo->nodeWeights);
+	free(chromo->nodeValues);
+	free(chromo->nodeActive);
+	free(chromo->nodeActArity);
+	free(chromo->nodeHashes);
 	free(chromo->outputNodes);
 	free(chromo->activeNodes);
+	free(chromo->planFunctions);
+	free(chromo->planArity);
+	free(chromo->planOperands);
+	free(chromo->planWeights);
+	free(chromo->planBlockFunctions);
+	free(chromo->planColumns);
+	free(chromo->planOutputColumns);
 	free(chromo);
 }
 
@@ -1097,22 +1960,22 @@ DLL_EXPORT void printChromosome(struct chromosome *chromo, int weights) {
 	for (i = 0; i < chromo->numNodes; i++) {
 
 		/* print the node function */
-		printf("(%d):\t%s\t", chromo->numInputs + i, chromo->funcSet->functionNames[chromo->nodes[i]->function]);
+		printf("(%d):\t%s\t", chromo->numInputs + i, chromo->funcSet->functionNames[chromo->nodeFunctions[i]]);
 
 		/* for the arity of the node */
 		for (j = 0; j < getChromosomeNodeArity(chromo, i); j++) {
 
 			/* print the node input information */
 			if (weights == 1) {
-				printf("%d,%+.1f\t", chromo->nodes[i]->inputs[j], chromo->nodes[i]->weights[j]);
+				printf("%d,%+.1f\t", chromo->nodeInputs[(i * chromo->arity) + j], chromo->nodeWeights[(i * chromo->arity) + j]);
 			}
 			else {
-				printf("%d ", chromo->nodes[i]->inputs[j]);
+				printf("%d ", chromo->nodeInputs[(i * chromo->arity) + j]);
 			}
 		}
 
 		/* Highlight active nodes */
-		if (chromo->nodes[i]->active == 1) {
+		if (chromo->nodeActive[i] == 1) {
 			printf("*");
 		}
 
@@ -1137,15 +2000,23 @@ DLL_EXPORT void printChromosome(struct chromosome *chromo, int weights) {
 */
 DLL_EXPORT void executeChromosome(struct chromosome *chromo, const double *inputs) {
 
-	int i, j;
-	int nodeInputLocation;
-	int currentActiveNode;
-	int currentActiveNodeFunction;
-	int nodeArity;
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: cannot execute uninitialised chromosome.\n Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-	const int numInputs = chromo->numInputs;
-	const int numActiveNodes = chromo->numActiveNodes;
-	const int numOutputs = chromo->numOutputs;
+	executeChromosomeValues(chromo, inputs, chromo->nodeValues, chromo->nodeInputsHold, chromo->outputValues);
+}
+
+
+/*
+	Executes the given chromosome using the node values of the given
+	execution state rather than those of the chromosome, which is not
+	changed. Many threads may therefore execute the same chromosome at
+	once, each with its own execution state.
+*/
+DLL_EXPORT void executeChromosomeWithState(struct chromosome *chromo, struct executionState *state, const double *inputs, double *outputs) {
 
 	/* error checking */
 	if (chromo == NULL) {
@@ -1153,2719 +2024,8298 @@ DLL_EXPORT void executeChromosome(struct chromosome *chromo, const double *input
 		exit(0);
 	}
 
-	/* for all of the active nodes */
-	for (i = 0; i < numActiveNodes; i++) {
+	if (state == NULL) {
+		printf("Error: cannot execute a chromosome with an uninitialised execution state.\n Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (state->numInputs != chromo->numInputs || state->numNodes != chromo->numNodes || state->numOutputs != chromo->numOutputs || state->arity != chromo->arity) {
+		printf("Error: the execution state was initialised for a chromosome of different dimensions.\n Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-		/* get the index of the current active node */
-		currentActiveNode = chromo->activeNodes[i];
+	executeChromosomeValues(chromo, inputs, state->nodeValues, state->nodeInputsHold, outputs);
+}
 
-		/* get the arity of the current node */
-		nodeArity = chromo->nodes[currentActiveNode]->actArity;
 
-		/* for each of the active nodes inputs */
-		for (j = 0; j < nodeArity; j++) {
+/*
+	Executes the given chromosome with the given node value and node input
+	buffers, writing the chromosome outputs to the outputs array. Only the
+	given buffers are written to.
+*/
+static void executeChromosomeValues(struct chromosome *chromo, const double *inputs, double *nodeValues, double *inputsHold, double *outputs) {
 
-			/* gather the nodes input locations */
-			nodeInputLocation = chromo->nodes[currentActiveNode]->inputs[j];
+	int i, j;
+	int nodeArity;
+	const int *nodeOperands;
+	double nodeOutput;
 
-			if (nodeInputLocation < numInputs) {
-				chromo->nodeInputsHold[j] = inputs[nodeInputLocation];
-			}
-			else {
-				chromo->nodeInputsHold[j] = chromo->nodes[nodeInputLocation - numInputs]->output;
-			}
-		}
+	/* use the native code if the chromosome has been compiled */
+	if (chromo->compiledFunction != NULL) {
+		chromo->compiledFunction(inputs, nodeValues, outputs);
+		return;
+	}
 
-		/* get the functionality of the active node under evaluation */
-		currentActiveNodeFunction = chromo->nodes[currentActiveNode]->function;
+	/* the chromosome inputs occupy the start of the value buffer */
+	memcpy(nodeValues, inputs, chromo->numInputs * sizeof(double));
 
-		/* calculate the output of the active node under evaluation */
-		chromo->nodes[currentActiveNode]->output = chromo->funcSet->functions[currentActiveNodeFunction](nodeArity, chromo->nodeInputsHold, chromo->nodes[currentActiveNode]->weights);
+	/* for each step in the execution plan, i.e. each active node in order */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
 
+		/* get the arity and operand slots of the current step */
+		nodeArity = chromo->planArity[i];
+		nodeOperands = chromo->planOperands + (i * chromo->arity);
 
-		/* deal with doubles becoming NAN */
-		if (isnan(chromo->nodes[currentActiveNode]->output) != 0) {
-			chromo->nodes[currentActiveNode]->output = 0;
+		/* gather the nodes input values */
+		for (j = 0; j < nodeArity; j++) {
+			inputsHold[j] = nodeValues[nodeOperands[j]];
 		}
 
-		/* prevent double form going to inf and -inf */
-		else if (isinf(chromo->nodes[currentActiveNode]->output) != 0 ) {
+		/* calculate the output of the active node under evaluation */
+		nodeOutput = chromo->planFunctions[i](nodeArity, inputsHold, chromo->planWeights + (i * chromo->arity));
 
-			if (chromo->nodes[currentActiveNode]->output > 0) {
-				chromo->nodes[currentActiveNode]->output = DBL_MAX;
-			}
-			else {
-				chromo->nodes[currentActiveNode]->output = DBL_MIN;
-			}
-		}
+		nodeValues[chromo->numInputs + chromo->activeNodes[i]] = sanitiseNodeOutput(nodeOutput);
 	}
 
 	/* Set the chromosome outputs */
-	for (i = 0; i < numOutputs; i++) {
-
-		if (chromo->outputNodes[i] < numInputs) {
-			chromo->outputValues[i] = inputs[chromo->outputNodes[i]];
-		}
-		else {
-			chromo->outputValues[i] = chromo->nodes[chromo->outputNodes[i] - numInputs]->output;
-		}
+	for (i = 0; i < chromo->numOutputs; i++) {
+		outputs[i] = nodeValues[chromo->outputNodes[i]];
 	}
 }
 
+
 /*
-	used to access the chromosome outputs after executeChromosome
-	has been called
+	Initialises an execution state for executing the given chromosome
+	using executeChromosomeWithState. The node values start at zero, as
+	after resetChromosome.
 */
-DLL_EXPORT double getChromosomeOutput(struct chromosome *chromo, int output) {
+DLL_EXPORT struct executionState *initialiseExecutionState(struct chromosome *chromo) {
 
-	if (output < 0 || output > chromo->numOutputs) {
-		printf("Error: output less than or greater than the number of chromosome outputs. Called from getChromosomeOutput.\n");
+	struct executionState *state;
+
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: cannot initialise an execution state for an uninitialised chromosome.\n Terminating CGP-Library.\n");
 		exit(0);
 	}
 
-	return chromo->outputValues[output];
-}
+	state = (struct executionState*)malloc(sizeof(struct executionState));
 
+	state->numInputs = chromo->numInputs;
+	state->numNodes = chromo->numNodes;
+	state->numOutputs = chromo->numOutputs;
+	state->arity = chromo->arity;
+
+	state->nodeValues = (double*)calloc(chromo->numInputs + chromo->numNodes, sizeof(double));
+	state->nodeInputsHold = (double*)malloc(chromo->arity * sizeof(double));
+
+	return state;
+}
 
 
 /*
-	used to access the chromosome node values after executeChromosome
-	has been called
+	Frees the memory associated with the given execution state
 */
-DLL_EXPORT double getChromosomeNodeValue(struct chromosome *chromo, int node) {
-	if (node < 0 || node > chromo->numNodes) {
-		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from getChromosomeNodeValue.\n");
-		exit(0);
+DLL_EXPORT void freeExecutionState(struct executionState *state) {
+
+	/* attempt to prevent user double freeing */
+	if (state == NULL) {
+		printf("Warning: double freeing of execution state prevented.\n");
+		return;
 	}
 
-	return chromo->nodes[node]->output;
+	free(state->nodeValues);
+	free(state->nodeInputsHold);
+	free(state);
 }
 
 
 /*
-	returns whether the specified node is active in the given chromosome
+	Resets the node values of the given execution state to zero, as
+	resetChromosome does for the chromosome
 */
-DLL_EXPORT int isNodeActive(struct chromosome *chromo, int node) {
-
-	if (node < 0 || node > chromo->numNodes) {
-		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from isNodeActive.\n");
-		exit(0);
-	}
+DLL_EXPORT void resetExecutionState(struct executionState *state) {
 
-	return chromo->nodes[node]->active;
+	memset(state->nodeValues + state->numInputs, 0, state->numNodes * sizeof(double));
 }
 
 
 /*
-	Saves the given chromosome in a form which can be read in later
+	Executes the given chromosome over numSamples rows of inputs stored
+	one after another in the inputs array, writing numOutputs outputs per
+	row to the outputs array. Samples are executed in blocks of
+	SAMPLEBLOCKSIZE so each active node is dispatched once per block
+	rather than once per sample.
 */
-DLL_EXPORT void saveChromosome(struct chromosome *chromo, char const *fileName) {
+DLL_EXPORT void executeChromosomeBatch(struct chromosome *chromo, const double *inputs, const int numSamples, double *outputs) {
 
 	int i, j;
-	FILE *fp;
-
-	/* create the chromosome file */
-	fp = fopen(fileName, "w");
+	int blockSize;
+	double *columns;
+	const double **operandColumns;
+	const double *inputRows[SAMPLEBLOCKSIZE];
 
-	/* ensure that the file was created correctly */
-	if (fp == NULL) {
-		printf("Warning: cannot save chromosome to '%s'. Chromosome was not saved.\n", fileName);
-		return;
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: cannot execute uninitialised chromosome.\n Terminating CGP-Library.\n");
+		exit(0);
 	}
 
-	/* save meta information */
-	fprintf(fp, "numInputs,%d\n", chromo->numInputs);
-	fprintf(fp, "numNodes,%d\n", chromo->numNodes);
-	fprintf(fp, "numOutputs,%d\n", chromo->numOutputs);
-	fprintf(fp, "arity,%d\n", chromo->arity);
+	columns = (double*)malloc((chromo->numInputs + chromo->numActiveNodes) * SAMPLEBLOCKSIZE * sizeof(double));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
 
-	fprintf(fp, "functionSet");
+	for (i = 0; i < numSamples; i += SAMPLEBLOCKSIZE) {
 
-	for (i = 0; i < chromo->funcSet->numFunctions; i++) {
-		fprintf(fp, ",%s", chromo->funcSet->functionNames[i]);
-	}
-	fprintf(fp, "\n");
+		blockSize = numSamples - i < SAMPLEBLOCKSIZE ? numSamples - i : SAMPLEBLOCKSIZE;
 
-	/* save the chromosome structure */
-	for (i = 0; i < chromo->numNodes; i++) {
-
-		fprintf(fp, "%d\n", chromo->nodes[i]->function);
-
-		for (j = 0; j < chromo->arity; j++) {
-			fprintf(fp, "%d,%f\n", chromo->nodes[i]->inputs[j], chromo->nodes[i]->weights[j]);
+		for (j = 0; j < blockSize; j++) {
+			inputRows[j] = inputs + ((i + j) * chromo->numInputs);
 		}
-	}
 
-	for (i = 0; i < chromo->numOutputs; i++) {
-		fprintf(fp, "%d,", chromo->outputNodes[i]);
+		executeChromosomeBlock(chromo, inputRows, blockSize, columns, operandColumns, outputs + (i * chromo->numOutputs));
 	}
 
-	fclose(fp);
+	free(columns);
+	free(operandColumns);
 }
 
 
 /*
-	save the given chromosome to a graphviz .dot file
-	(www.graphviz.org/‎)
+	Executes the given chromosome over a block of at most SAMPLEBLOCKSIZE
+	samples. The columns buffer holds SAMPLEBLOCKSIZE values for each
+	chromosome input and active node, and the outputs are written row by
+	row. On return the chromosome holds the node values and outputs of the
+	last sample, as if executeChromosome had been called on each in turn.
 */
-DLL_EXPORT void saveChromosomeDot(struct chromosome *chromo, int weights, char const *fileName) {
+static void executeChromosomeBlock(struct chromosome *chromo, const double **inputRows, const int numSamples, double *columns, const double **operandColumns, double *outputs) {
 
-	int i, j;
-	FILE *fp;
+	int i, j, k;
 
-	char colour[20];
-	char weight[20];
+	const int numInputs = chromo->numInputs;
+	const int numOutputs = chromo->numOutputs;
 
-	fp = fopen(fileName, "w");
+	/* recurrent connections read the previous samples node values so must be executed a sample at a time */
+	if (chromo->planIsFeedForward == 0) {
+
+		for (k = 0; k < numSamples; k++) {
+			executeChromosome(chromo, inputRows[k]);
+			memcpy(outputs + (k * numOutputs), chromo->outputValues, numOutputs * sizeof(double));
+		}
 
-	if (fp == NULL) {
 		return;
 	}
 
-	/* */
-	fprintf(fp, "digraph NeuralNetwork {\n");
-
-	/* landscape, square and centre */
-	fprintf(fp, "rankdir=LR;\n");
-	fprintf(fp, "size=\"4,3\";\n");
-	fprintf(fp, "center = true;\n");
+	executePlanBlock(chromo, inputRows, numSamples, columns, operandColumns, chromo->nodeInputsHold, outputs);
 
-	/* for all the inputs */
-	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
+	/* leave the chromosome in the state of the last sample */
+	k = numSamples - 1;
 
-		fprintf(fp, "node%d [label=\"(%d) Input\", color=black, labelfontcolor=black, fontcolor=black];\n", i, i);
+	for (j = 0; j < numInputs; j++) {
+		chromo->nodeValues[j] = inputRows[k][j];
 	}
 
-	/* for all nodes */
-	for (i = 0; i < getNumChromosomeNodes(chromo); i++) {
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		chromo->nodeValues[numInputs + chromo->activeNodes[i]] = columns[((numInputs + i) * SAMPLEBLOCKSIZE) + k];
+	}
 
-		if (chromo->nodes[i]->active == 1) {
-			strncpy(colour, "black", 20);
-		}
-		else {
-			strncpy(colour, "lightgrey", 20);
-		}
+	for (j = 0; j < numOutputs; j++) {
+		chromo->outputValues[j] = outputs[(k * numOutputs) + j];
+	}
+}
 
-		fprintf(fp, "node%d [label=\"(%d) %s\", color=%s, labelfontcolor=%s, fontcolor=%s];\n", i + getNumChromosomeInputs(chromo), i + getNumChromosomeInputs(chromo), chromo->funcSet->functionNames[chromo->nodes[i]->function], colour, colour, colour);
 
-		/* for each node input */
-		for (j = 0; j < getChromosomeNodeArity(chromo, i); j++) {
+/*
+	Applies the execution plan of the given feed-forward chromosome to a
+	block of at most SAMPLEBLOCKSIZE samples, as executeChromosomeBlock,
+	without changing the chromosome. The inputsHold buffer holds arity
+	values for custom node functions. Blocks of the same chromosome may
+	therefore be executed at the same time given separate buffers.
+*/
+static void executePlanBlock(struct chromosome *chromo, const double **inputRows, const int numSamples, double *columns, const double **operandColumns, double *inputsHold, double *outputs) {
 
-			if (weights == 1) {
-				snprintf(weight, 20, "%.2f", chromo->nodes[i]->weights[j]);
-			}
-			else {
-				snprintf(weight, 20, " (%d)", j);
-			}
+	int j, k;
 
+	const int numInputs = chromo->numInputs;
 
-			fprintf(fp, "node%d -> node%d [label=\"%s\", labelfontcolor=%s, fontcolor=%s, bold=true, color=%s];\n", chromo->nodes[i]->inputs[j], i + getNumChromosomeInputs(chromo), weight, colour, colour, colour);
+	/* one column per chromosome input */
+	for (k = 0; k < numSamples; k++) {
+		for (j = 0; j < numInputs; j++) {
+			columns[(j * SAMPLEBLOCKSIZE) + k] = inputRows[k][j];
 		}
 	}
 
-	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
+	executePlanColumns(chromo, numSamples, columns, operandColumns, inputsHold, outputs);
+}
 
-		fprintf(fp, "node%d [label=\"Output %d\", color=black, labelfontcolor=black, fontcolor=black];\n", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo), i);
 
-		fprintf(fp, "node%d -> node%d [labelfontcolor=black, fontcolor=black, bold=true, color=black];\n", chromo->outputNodes[i], i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
-	}
+/*
+	Applies the execution plan of the given feed-forward chromosome to a
+	block of at most SAMPLEBLOCKSIZE samples whose inputs are already in
+	the first columns of the columns buffer, as executePlanBlock.
+*/
+static void executePlanColumns(struct chromosome *chromo, const int numSamples, double *columns, const double **operandColumns, double *inputsHold, double *outputs) {
 
+	int i, j, k;
+	const int *stepColumns;
 
-	/* place inputs  on same line */
-	fprintf(fp, "{ rank = source;");
+	const int numInputs = chromo->numInputs;
+	const int numOutputs = chromo->numOutputs;
 
-	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
-		fprintf(fp, " \"node%d\";", i);
-	}
-	fprintf(fp, " }\n");
+	/* for each step in the execution plan */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
 
+		stepColumns = chromo->planColumns + (i * chromo->arity);
 
-	/* place outputs  on same line */
-	fprintf(fp, "{ rank = max;");
+		for (j = 0; j < chromo->planArity[i]; j++) {
+			operandColumns[j] = columns + (stepColumns[j] * SAMPLEBLOCKSIZE);
+		}
 
-	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
-		fprintf(fp, "\"node%d\";", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
+		executePlanStepBlock(chromo, i, operandColumns, inputsHold, columns + ((numInputs + i) * SAMPLEBLOCKSIZE), numSamples);
 	}
-	fprintf(fp, " }\n");
-
-
-	/* last line of dot file */
-	fprintf(fp, "}");
 
-	fclose(fp);
+	/* gather the chromosome outputs */
+	for (k = 0; k < numSamples; k++) {
+		for (j = 0; j < numOutputs; j++) {
+			outputs[(k * numOutputs) + j] = columns[(chromo->planOutputColumns[j] * SAMPLEBLOCKSIZE) + k];
+		}
+	}
 }
 
 
 /*
-	save the given chromosome as a latex equation
-
-	Only compatible with feed-forward networks
-	Only fully compatible with custom node functions
+	Applies the execution plan of the given feed-forward chromosome to
+	numSamples rows of inputs using buffers of its own, writing the outputs
+	row by row. The chromosome is not changed.
 */
-DLL_EXPORT void saveChromosomeLatex(struct chromosome *chromo, int weights, char const *fileName) {
+static void executePlanSamples(struct chromosome *chromo, const double **inputRows, const int numSamples, double *outputs) {
 
-	int output;
 	int i;
-	FILE *fp;
+	int blockSize;
+	double *columns;
+	double *inputsHold;
+	const double **operandColumns;
 
-	fp = fopen(fileName, "w");
+	columns = (double*)malloc((chromo->numInputs + chromo->numActiveNodes) * SAMPLEBLOCKSIZE * sizeof(double));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
+	inputsHold = (double*)malloc((chromo->arity + 1) * sizeof(double));
 
-	if (fp == NULL) {
-		return;
+	for (i = 0; i < numSamples; i += SAMPLEBLOCKSIZE) {
+
+		blockSize = numSamples - i < SAMPLEBLOCKSIZE ? numSamples - i : SAMPLEBLOCKSIZE;
+
+		executePlanBlock(chromo, inputRows + i, blockSize, columns, operandColumns, inputsHold, outputs + (i * chromo->numOutputs));
 	}
 
-	/* document header */
-	fprintf(fp, "\\documentclass{article}\n");
-	fprintf(fp, "\\begin{document}\n");
+	free(columns);
+	free(operandColumns);
+	free(inputsHold);
+}
 
-	for (output = 0; output < chromo->numOutputs; output++) {
 
-		fprintf(fp, "\\begin{equation}\n");
+/*
+	Applies the given step of the execution plan to a block of samples,
+	given one column of values for each node input. Custom node functions
+	are given their inputs in the inputsHold buffer, so steps of the same
+	chromosome may be applied at the same time given separate buffers.
+*/
+static void executePlanStepBlock(struct chromosome *chromo, int step, const double **operandColumns, double *inputsHold, double *nodeOutputs, const int numSamples) {
 
-		/* function inputs */
-		if (chromo->numInputs == 0) {
-			fprintf(fp, "f()=");
-		}
-		else {
+	int j, k;
 
-			fprintf(fp, "f_%d(x_0", output);
+	const int nodeArity = chromo->planArity[step];
+	const double *stepWeights = chromo->planWeights + (step * chromo->arity);
 
-			for (i = 1; i < chromo->numInputs; i++) {
+	/* preset functions have a block variant */
+	if (chromo->planBlockFunctions[step] != NULL) {
+		chromo->planBlockFunctions[step](nodeArity, operandColumns, stepWeights, nodeOutputs, numSamples);
+	}
 
-				fprintf(fp, ",x_%d", i);
+	/* custom functions are called a sample at a time */
+	else {
+		for (k = 0; k < numSamples; k++) {
+
+			for (j = 0; j < nodeArity; j++) {
+				inputsHold[j] = operandColumns[j][k];
 			}
 
-			fprintf(fp, ")=");
+			nodeOutputs[k] = chromo->planFunctions[step](nodeArity, inputsHold, stepWeights);
 		}
-
-		saveChromosomeLatexRecursive(chromo, chromo->outputNodes[output], fp);
-
-		fprintf(fp, "\n\\end{equation}");
 	}
 
-
-	/* document footer */
-	fprintf(fp, "\n\\end{document}");
-
-	fclose(fp);
+	for (k = 0; k < numSamples; k++) {
+		nodeOutputs[k] = sanitiseNodeOutput(nodeOutputs[k]);
+	}
 }
 
+
 /*
-	used by saveChromosomeLatex
+	Prevents node outputs becoming NAN, inf or -inf
 */
-static void saveChromosomeLatexRecursive(struct chromosome *chromo, int index, FILE *fp) {
+static double sanitiseNodeOutput(double nodeOutput) {
 
-	int i;
-
-	if (index < chromo->numInputs) {
-		fprintf(fp, "x_%d", index);
-		return;
+	/* deal with doubles becoming NAN */
+	if (isnan(nodeOutput) != 0) {
+		nodeOutput = 0;
 	}
 
-	/* add */
-	if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "add", FUNCTIONNAMELENGTH) == 0 ) {
-
-		fprintf(fp, "\\left(");
-
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
-
-		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
-
-			fprintf(fp, " + ");
+	/* prevent double form going to inf and -inf */
+	else if (isinf(nodeOutput) != 0 ) {
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+		if (nodeOutput > 0) {
+			nodeOutput = DBL_MAX;
+		}
+		else {
+			nodeOutput = DBL_MIN;
 		}
-
-		fprintf(fp, "\\right)");
 	}
 
+	return nodeOutput;
+}
 
-	/* sub */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sub", FUNCTIONNAMELENGTH) == 0 ) {
 
-		fprintf(fp, "\\left(");
+/*
+	Compiles the active nodes of the given chromosome to native code which
+	is then used by executeChromosome. The execution plan is written out as
+	straight line C, built into a shared object with the compiler named by
+	the CGP_CC environment variable (cc by default) and loaded with dlopen.
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	Compiled code is cached by its source, a canonical form of the active
+	genotype, so chromosomes which reappear are not compiled again.
 
-		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+	Returns one if the chromosome was compiled and zero if it continues to
+	use the interpreter. This is the case if the chromosome uses custom
+	node functions, no compiler is available, the cache of compiled
+	chromosomes is full or the platform does not support loading shared
+	objects.
+*/
+DLL_EXPORT int compileChromosome(struct chromosome *chromo) {
 
-			fprintf(fp, " - ");
+#ifdef NATIVECOMPILATION
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-		}
+	int cacheIndex = -1;
+	int cacheFull = 0;
+	char *source;
+	unsigned long long hash;
+	void *handle = NULL;
+	void (*compiledFunction)(const double *inputs, double *values, double *outputs) = NULL;
 
-		fprintf(fp, "\\right)");
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: cannot compile uninitialised chromosome.\n Terminating CGP-Library.\n");
+		exit(0);
 	}
 
-	/* mul */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "mul", FUNCTIONNAMELENGTH) == 0 ) {
+	if (chromo->compiledFunction != NULL) {
+		return 1;
+	}
 
-		fprintf(fp, "\\left(");
+	if (nativeCompilerUnavailable == 1) {
+		return 0;
+	}
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	source = getChromosomeSource(chromo);
 
-		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+	/* chromosome uses node functions which cannot be compiled */
+	if (source == NULL) {
+		return 0;
+	}
 
-			fprintf(fp, " \\times ");
+	hash = hashBytes(HASHOFFSETBASIS, source, strlen(source));
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-		}
+	#pragma omp critical (compiledChromosomeCache)
+	{
+		cacheIndex = findCompiledChromosome(hash, source);
+		cacheFull = numCompiledChromosomes >= COMPILEDCHROMOSOMECACHESIZE;
+	}
 
-		fprintf(fp, "\\right)");
+	if (cacheIndex >= 0) {
+		chromo->compiledFunction = compiledChromosomeCache[cacheIndex].function;
+		free(source);
+		return 1;
 	}
 
-	/* div (change to frac)*/
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "div", FUNCTIONNAMELENGTH) == 0 ) {
+	/* the compiled code could not be kept so do not invoke the compiler */
+	if (cacheFull == 1) {
+		free(source);
+		return 0;
+	}
 
-		if (getChromosomeNodeArity(chromo, index - chromo->numInputs) == 1) {
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
-		}
-		else {
+	/* compile outside of the critical section so threads can compile concurrently */
+	compiledFunction = compileChromosomeSource(source, &handle);
 
-			for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+	if (compiledFunction == NULL) {
 
-				if (i + 1 < getChromosomeNodeArity(chromo, index - chromo->numInputs)) {
-					fprintf(fp, "\\frac{");
-					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-					fprintf(fp, "}{");
-				}
-				else if (i + 1 == getChromosomeNodeArity(chromo, index - chromo->numInputs) && getChromosomeNodeArity(chromo, index - chromo->numInputs) > 2) {
-					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-					fprintf(fp, "}}");
-				}
-				else {
-					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-					fprintf(fp, "}");
-				}
+		#pragma omp critical (compiledChromosomeCache)
+		{
+			if (nativeCompilerUnavailable == 0) {
+				printf("Warning: chromosomes could not be compiled to native code. The interpreter is used instead.\n");
+				nativeCompilerUnavailable = 1;
 			}
 		}
+
+		free(source);
+		return 0;
 	}
 
-	/* abs */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "abs", FUNCTIONNAMELENGTH) == 0 ) {
+	#pragma omp critical (compiledChromosomeCache)
+	{
+		/* another thread may have compiled the same chromosome in the meantime */
+		cacheIndex = findCompiledChromosome(hash, source);
 
-		fprintf(fp, " \\left|");
+		if (cacheIndex < 0 && numCompiledChromosomes < COMPILEDCHROMOSOMECACHESIZE) {
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+			compiledChromosomeCache[numCompiledChromosomes].hash = hash;
+			compiledChromosomeCache[numCompiledChromosomes].source = source;
+			compiledChromosomeCache[numCompiledChromosomes].function = compiledFunction;
 
-		fprintf(fp, " \\right|");
+			cacheIndex = numCompiledChromosomes;
+			numCompiledChromosomes++;
+			source = NULL;
+			handle = NULL;
+		}
+	}
 
+	/* compiled code can only be used once owned by the cache as it is never unloaded */
+	if (handle != NULL) {
+		dlclose(handle);
 	}
 
-	/* sqrt */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sqrt", FUNCTIONNAMELENGTH) == 0 ) {
+	free(source);
 
-		fprintf(fp, " \\sqrt{");
+	if (cacheIndex < 0) {
+		return 0;
+	}
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	chromo->compiledFunction = compiledChromosomeCache[cacheIndex].function;
 
-		fprintf(fp, " }");
+	return 1;
+
+#else
 
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: cannot compile uninitialised chromosome.\n Terminating CGP-Library.\n");
+		exit(0);
 	}
 
+	return 0;
 
-	/* sq */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sq", FUNCTIONNAMELENGTH) == 0 ) {
+#endif
+}
 
-		fprintf(fp, " (");
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+#ifdef NATIVECOMPILATION
 
-		fprintf(fp, " )^2");
+/*
+	Returns the index of the compiled chromosome with the given hash and
+	source in the compiled chromosome cache, or -1 if there is none.
+	Must be called from within the compiledChromosomeCache critical section.
+*/
+static int findCompiledChromosome(unsigned long long hash, const char *source) {
 
+	int i;
+
+	for (i = 0; i < numCompiledChromosomes; i++) {
+
+		if (compiledChromosomeCache[i].hash == hash && strcmp(compiledChromosomeCache[i].source, source) == 0) {
+			return i;
+		}
 	}
 
-	/* cube */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "cube", FUNCTIONNAMELENGTH) == 0 ) {
+	return -1;
+}
 
-		fprintf(fp, " (");
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+/*
+	Builds the given chromosome source into a shared object and loads it.
+	Returns the compiled function and sets handle to the loaded object,
+	or returns NULL if the source could not be compiled or loaded.
+*/
+static void (*compileChromosomeSource(const char *source, void **handle))(const double *inputs, double *values, double *outputs) {
+
+	char directory[] = "/tmp/cgpXXXXXX";
+	char sourceFile[64];
+	char objectFile[64];
+	char command[512];
+	const char *compiler;
+	FILE *fp;
+	int compiled;
+	void (*compiledFunction)(const double *inputs, double *values, double *outputs) = NULL;
 
-		fprintf(fp, " )^3");
+	*handle = NULL;
 
+	if (mkdtemp(directory) == NULL) {
+		return NULL;
 	}
 
-	/* exp */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "exp", FUNCTIONNAMELENGTH) == 0 ) {
+	snprintf(sourceFile, sizeof(sourceFile), "%s/chromosome.c", directory);
+	snprintf(objectFile, sizeof(objectFile), "%s/chromosome.so", directory);
 
-		fprintf(fp, " e^{");
+	fp = fopen(sourceFile, "w");
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	if (fp == NULL) {
+		rmdir(directory);
+		return NULL;
+	}
 
-		fprintf(fp, " }");
+	fputs(source, fp);
+	fclose(fp);
 
+	compiler = getenv("CGP_CC");
+
+	if (compiler == NULL) {
+		compiler = "cc";
 	}
 
-	/* sin */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sin", FUNCTIONNAMELENGTH) == 0 ) {
+	/* contraction is disabled so the compiled code rounds exactly as the interpreter */
+	snprintf(command, sizeof(command), "%s -O2 -fPIC -shared -ffp-contract=off -o %s %s -lm > /dev/null 2>&1", compiler, objectFile, sourceFile);
 
-		fprintf(fp, "\\sin(");
+	compiled = system(command) == 0;
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	if (compiled) {
 
-		fprintf(fp, " )");
+		*handle = dlopen(objectFile, RTLD_NOW | RTLD_LOCAL);
 
+		if (*handle != NULL) {
+			*(void **)(&compiledFunction) = dlsym(*handle, "executeCompiledChromosome");
+		}
 	}
 
-	/* cos */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "cos", FUNCTIONNAMELENGTH) == 0 ) {
-
-		fprintf(fp, " \\cos(");
+	/* once loaded the files are no longer needed */
+	remove(objectFile);
+	remove(sourceFile);
+	rmdir(directory);
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	if (compiledFunction == NULL && *handle != NULL) {
+		dlclose(*handle);
+		*handle = NULL;
+	}
 
-		fprintf(fp, " )");
+	return compiledFunction;
+}
 
-	}
 
-	/* tan */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "tan", FUNCTIONNAMELENGTH) == 0 ) {
+/*
+	Returns the C source of the given chromosomes execution plan as a
+	single function executeCompiledChromosome(inputs, values, outputs),
+	or NULL if it uses node functions which cannot be compiled. The
+	returned string must be freed by the caller.
 
-		fprintf(fp, " \\tan(");
+	Every node computes exactly the same operations in the same order as
+	the corresponding preset node function, so the compiled code gives
+	identical results to the interpreter. Values computed earlier in the
+	same execution are held in local variables; recurrent connections
+	read the previous values from the values buffer.
+*/
+static char *getChromosomeSource(struct chromosome *chromo) {
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	int i, j;
+	int nodeIndex;
+	int nodeArity;
+	const int *nodeOperands;
+	const double *nodeWeights;
+	double (*function)(const int numInputs, const double *inputs, const double *connectionWeights);
+	struct sourceBuffer buf = {NULL, 0, 0};
 
-		fprintf(fp, " )");
+	const int numInputs = chromo->numInputs;
 
+	/* all functions must be presets; rand uses the library's random number streams */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		if (chromo->planBlockFunctions[i] == NULL) {
+			return NULL;
+		}
 	}
 
-	/* rand */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "rand", FUNCTIONNAMELENGTH) == 0 ) {
+	appendSource(&buf, "#include <math.h>\n#include <float.h>\n\n");
+	appendSource(&buf, "static double sanitise(double x) {\n\tif (isnan(x)) return 0;\n\tif (isinf(x)) return x > 0 ? DBL_MAX : DBL_MIN;\n\treturn x;\n}\n\n");
+	appendSource(&buf, "void executeCompiledChromosome(const double *in, double *v, double *out) {\n");
+	appendSource(&buf, "\tdouble w;\n");
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		nodeIndex = chromo->activeNodes[i];
+		nodeArity = chromo->planArity[i];
+		nodeOperands = chromo->planOperands + (i * chromo->arity);
+		nodeWeights = chromo->planWeights + (i * chromo->arity);
+		function = chromo->planFunctions[i];
+
+		/* the weighted neuron functions need the weighted input sum first */
+		if (function == _sigmoid || function == _gaussian || function == _step || function == _softsign || function == _hyperbolicTangent) {
+
+			appendSource(&buf, "\tw = 0.0;\n");
+
+			for (j = 0; j < nodeArity; j++) {
+				appendSource(&buf, "\tw += (");
+				appendOperandSource(&buf, chromo, i, nodeOperands[j]);
+				appendSource(&buf, " * %a);\n", nodeWeights[j]);
+			}
+		}
+
+		appendSource(&buf, "\tdouble n%d = sanitise(", nodeIndex);
+
+		if (function == _add || function == _sub || function == _mul || function == _divide) {
+
+			for (j = 1; j < nodeArity; j++) {
+				appendSource(&buf, "(");
+			}
+
+			appendOperandSource(&buf, chromo, i, nodeOperands[0]);
+
+			for (j = 1; j < nodeArity; j++) {
+				appendSource(&buf, " %c ", function == _add ? '+' : function == _sub ? '-' : function == _mul ? '*' : '/');
+				appendOperandSource(&buf, chromo, i, nodeOperands[j]);
+				appendSource(&buf, ")");
+			}
+		}
+		else if (function == _absolute || function == _squareRoot || function == _exponential || function == _sine || function == _cosine || function == _tangent) {
+			appendSource(&buf, "%s(", function == _absolute ? "fabs" : function == _squareRoot ? "sqrt" : function == _exponential ? "exp" : function == _sine ? "sin" : function == _cosine ? "cos" : "tan");
+			appendOperandSource(&buf, chromo, i, nodeOperands[0]);
+			appendSource(&buf, ")");
+		}
+		else if (function == _square || function == _cube) {
+			appendSource(&buf, "pow(");
+			appendOperandSource(&buf, chromo, i, nodeOperands[0]);
+			appendSource(&buf, ", %d)", function == _square ? 2 : 3);
+		}
+		else if (function == _power) {
+			appendSource(&buf, "pow(");
+			appendOperandSource(&buf, chromo, i, nodeOperands[0]);
+			appendSource(&buf, ", ");
+			appendOperandSource(&buf, chromo, i, nodeOperands[1]);
+			appendSource(&buf, ")");
+		}
+		else if (function == _and || function == _nand || function == _or || function == _nor) {
+
+			appendSource(&buf, "(0");
+
+			for (j = 0; j < nodeArity; j++) {
+				appendSource(&buf, " || ");
+				appendOperandSource(&buf, chromo, i, nodeOperands[j]);
+				appendSource(&buf, " == %d", function == _and || function == _nand ? 0 : 1);
+			}
+
+			appendSource(&buf, ") ? %s", function == _and || function == _nor ? "0 : 1" : "1 : 0");
+		}
+		else if (function == _xor || function == _xnor) {
+
+			appendSource(&buf, "(0");
+
+			for (j = 0; j < nodeArity; j++) {
+				appendSource(&buf, " + (");
+				appendOperandSource(&buf, chromo, i, nodeOperands[j]);
+				appendSource(&buf, " == 1)");
+			}
+
+			appendSource(&buf, ") == 1 ? %s", function == _xor ? "1 : 0" : "0 : 1");
+		}
+		else if (function == _not) {
+			appendOperandSource(&buf, chromo, i, nodeOperands[0]);
+			appendSource(&buf, " == 0 ? 1 : 0");
+		}
+		else if (function == _wire) {
+			appendOperandSource(&buf, chromo, i, nodeOperands[0]);
+		}
+		else if (function == _sigmoid) {
+			appendSource(&buf, "1 / (1 + exp(-w))");
+		}
+		else if (function == _gaussian) {
+			appendSource(&buf, "exp(-(pow(w - 0, 2)) / (2 * pow(1, 2)))");
+		}
+		else if (function == _step) {
+			appendSource(&buf, "w < 0 ? 0 : 1");
+		}
+		else if (function == _softsign) {
+			appendSource(&buf, "w / (1 + fabs(w))");
+		}
+		else if (function == _hyperbolicTangent) {
+			appendSource(&buf, "tanh(w)");
+		}
+		else if (function == _constOne) {
+			appendSource(&buf, "1");
+		}
+		else if (function == _constZero) {
+			appendSource(&buf, "0");
+		}
+		else if (function == _constPI) {
+			appendSource(&buf, "%a", M_PI);
+		}
+
+		appendSource(&buf, ");\n");
+	}
+
+	/* leave the values buffer as executeChromosome would */
+	for (i = 0; i < numInputs; i++) {
+		appendSource(&buf, "\tv[%d] = in[%d];\n", i, i);
+	}
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		appendSource(&buf, "\tv[%d] = n%d;\n", numInputs + chromo->activeNodes[i], chromo->activeNodes[i]);
+	}
+
+	for (i = 0; i < chromo->numOutputs; i++) {
+		appendSource(&buf, "\tout[%d] = v[%d];\n", i, chromo->outputNodes[i]);
+	}
+
+	appendSource(&buf, "\t(void)w;\n}\n");
+
+	return buf.text;
+}
+
+
+/*
+	Appends the source reading the given operand slot from within the given
+	step of the execution plan. Inputs and nodes already computed by an
+	earlier step are read directly; later nodes are recurrent connections
+	and read their value from the previous execution.
+*/
+static void appendOperandSource(struct sourceBuffer *buf, struct chromosome *chromo, int step, int operand) {
+
+	if (operand < chromo->numInputs) {
+		appendSource(buf, "in[%d]", operand);
+	}
+	else if (operand - chromo->numInputs < chromo->activeNodes[step]) {
+		appendSource(buf, "n%d", operand - chromo->numInputs);
+	}
+	else {
+		appendSource(buf, "v[%d]", operand);
+	}
+}
+
+
+/*
+	printf style append to the given source buffer
+*/
+static void appendSource(struct sourceBuffer *buf, const char *format, ...) {
+
+	int length;
+	va_list args;
+
+	va_start(args, format);
+	length = vsnprintf(NULL, 0, format, args);
+	va_end(args);
+
+	if (buf->length + length + 1 > buf->capacity) {
+		buf->capacity = (buf->capacity + length + 1) * 2;
+		buf->text = (char*)realloc(buf->text, buf->capacity * sizeof(char));
+	}
+
+	va_start(args, format);
+	vsnprintf(buf->text + buf->length, length + 1, format, args);
+	va_end(args);
+
+	buf->length += length;
+}
+
+
+#endif
+
+/*
+	used to access the chromosome outputs after executeChromosome
+	has been called
+*/
+DLL_EXPORT double getChromosomeOutput(struct chromosome *chromo, int output) {
+
+	if (output < 0 || output > chromo->numOutputs) {
+		printf("Error: output less than or greater than the number of chromosome outputs. Called from getChromosomeOutput.\n");
+		exit(0);
+	}
+
+	return chromo->outputValues[output];
+}
+
+
+
+/*
+	used to access the chromosome node values after executeChromosome
+	has been called
+*/
+DLL_EXPORT double getChromosomeNodeValue(struct chromosome *chromo, int node) {
+	if (node < 0 || node > chromo->numNodes) {
+		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from getChromosomeNodeValue.\n");
+		exit(0);
+	}
+
+	return chromo->nodeValues[chromo->numInputs + node];
+}
+
+
+/*
+	returns whether the specified node is active in the given chromosome
+*/
+DLL_EXPORT int isNodeActive(struct chromosome *chromo, int node) {
+
+	if (node < 0 || node > chromo->numNodes) {
+		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from isNodeActive.\n");
+		exit(0);
+	}
+
+	return chromo->nodeActive[node];
+}
+
+
+/*
+	Saves the given chromosome in a form which can be read in later
+*/
+DLL_EXPORT void saveChromosome(struct chromosome *chromo, char const *fileName) {
+
+	int i, j;
+	FILE *fp;
+
+	/* create the chromosome file */
+	fp = fopen(fileName, "w");
+
+	/* ensure that the file was created correctly */
+	if (fp == NULL) {
+		printf("Warning: cannot save chromosome to '%s'. Chromosome was not saved.\n", fileName);
+		return;
+	}
+
+	/* save meta information */
+	fprintf(fp, "numInputs,%d\n", chromo->numInputs);
+	fprintf(fp, "numNodes,%d\n", chromo->numNodes);
+	fprintf(fp, "numOutputs,%d\n", chromo->numOutputs);
+	fprintf(fp, "arity,%d\n", chromo->arity);
+
+	fprintf(fp, "functionSet");
+
+	for (i = 0; i < chromo->funcSet->numFunctions; i++) {
+		fprintf(fp, ",%s", chromo->funcSet->functionNames[i]);
+	}
+	fprintf(fp, "\n");
+
+	/* save the chromosome structure */
+	for (i = 0; i < chromo->numNodes; i++) {
+
+		fprintf(fp, "%d\n", chromo->nodeFunctions[i]);
+
+		for (j = 0; j < chromo->arity; j++) {
+			fprintf(fp, "%d,%f\n", chromo->nodeInputs[(i * chromo->arity) + j], chromo->nodeWeights[(i * chromo->arity) + j]);
+		}
+	}
+
+	for (i = 0; i < chromo->numOutputs; i++) {
+		fprintf(fp, "%d,", chromo->outputNodes[i]);
+	}
+
+	fclose(fp);
+}
+
+
+/*
+	save the given chromosome to a graphviz .dot file
+	(www.graphviz.org/‎)
+*/
+DLL_EXPORT void saveChromosomeDot(struct chromosome *chromo, int weights, char const *fileName) {
+
+	int i, j;
+	FILE *fp;
+
+	char colour[20];
+	char weight[20];
+
+	fp = fopen(fileName, "w");
+
+	if (fp == NULL) {
+		return;
+	}
+
+	/* */
+	fprintf(fp, "digraph NeuralNetwork {\n");
+
+	/* landscape, square and centre */
+	fprintf(fp, "rankdir=LR;\n");
+	fprintf(fp, "size=\"4,3\";\n");
+	fprintf(fp, "center = true;\n");
+
+	/* for all the inputs */
+	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
+
+		fprintf(fp, "node%d [label=\"(%d) Input\", color=black, labelfontcolor=black, fontcolor=black];\n", i, i);
+	}
+
+	/* for all nodes */
+	for (i = 0; i < getNumChromosomeNodes(chromo); i++) {
+
+		if (chromo->nodeActive[i] == 1) {
+			strncpy(colour, "black", 20);
+		}
+		else {
+			strncpy(colour, "lightgrey", 20);
+		}
+
+		fprintf(fp, "node%d [label=\"(%d) %s\", color=%s, labelfontcolor=%s, fontcolor=%s];\n", i + getNumChromosomeInputs(chromo), i + getNumChromosomeInputs(chromo), chromo->funcSet->functionNames[chromo->nodeFunctions[i]], colour, colour, colour);
+
+		/* for each node input */
+		for (j = 0; j < getChromosomeNodeArity(chromo, i); j++) {
+
+			if (weights == 1) {
+				snprintf(weight, 20, "%.2f", chromo->nodeWeights[(i * chromo->arity) + j]);
+			}
+			else {
+				snprintf(weight, 20, " (%d)", j);
+			}
+
+
+			fprintf(fp, "node%d -> node%d [label=\"%s\", labelfontcolor=%s, fontcolor=%s, bold=true, color=%s];\n", chromo->nodeInputs[(i * chromo->arity) + j], i + getNumChromosomeInputs(chromo), weight, colour, colour, colour);
+		}
+	}
+
+	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
+
+		fprintf(fp, "node%d [label=\"Output %d\", color=black, labelfontcolor=black, fontcolor=black];\n", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo), i);
+
+		fprintf(fp, "node%d -> node%d [labelfontcolor=black, fontcolor=black, bold=true, color=black];\n", chromo->outputNodes[i], i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
+	}
+
+
+	/* place inputs  on same line */
+	fprintf(fp, "{ rank = source;");
+
+	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
+		fprintf(fp, " \"node%d\";", i);
+	}
+	fprintf(fp, " }\n");
+
+
+	/* place outputs  on same line */
+	fprintf(fp, "{ rank = max;");
+
+	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
+		fprintf(fp, "\"node%d\";", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
+	}
+	fprintf(fp, " }\n");
+
+
+	/* last line of dot file */
+	fprintf(fp, "}");
+
+	fclose(fp);
+}
+
+
+/*
+	save the given chromosome as a latex equation
+
+	Only compatible with feed-forward networks
+	Only fully compatible with custom node functions
+*/
+DLL_EXPORT void saveChromosomeLatex(struct chromosome *chromo, int weights, char const *fileName) {
+
+	int output;
+	int i;
+	FILE *fp;
+
+	fp = fopen(fileName, "w");
+
+	if (fp == NULL) {
+		return;
+	}
+
+	/* document header */
+	fprintf(fp, "\\documentclass{article}\n");
+	fprintf(fp, "\\begin{document}\n");
+
+	for (output = 0; output < chromo->numOutputs; output++) {
+
+		fprintf(fp, "\\begin{equation}\n");
+
+		/* function inputs */
+		if (chromo->numInputs == 0) {
+			fprintf(fp, "f()=");
+		}
+		else {
+
+			fprintf(fp, "f_%d(x_0", output);
+
+			for (i = 1; i < chromo->numInputs; i++) {
+
+				fprintf(fp, ",x_%d", i);
+			}
+
+			fprintf(fp, ")=");
+		}
+
+		saveChromosomeLatexRecursive(chromo, chromo->outputNodes[output], fp);
+
+		fprintf(fp, "\n\\end{equation}");
+	}
+
+
+	/* document footer */
+	fprintf(fp, "\n\\end{document}");
+
+	fclose(fp);
+}
+
+/*
+	used by saveChromosomeLatex
+*/
+static void saveChromosomeLatexRecursive(struct chromosome *chromo, int index, FILE *fp) {
+
+	int i;
+
+	if (index < chromo->numInputs) {
+		fprintf(fp, "x_%d", index);
+		return;
+	}
+
+	/* add */
+	if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "add", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, "\\left(");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+
+			fprintf(fp, " + ");
+
+			saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[((index - chromo->numInputs) * chromo->arity) + i], fp);
+		}
+
+		fprintf(fp, "\\right)");
+	}
+
+
+	/* sub */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "sub", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, "\\left(");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+
+			fprintf(fp, " - ");
+
+			saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[((index - chromo->numInputs) * chromo->arity) + i], fp);
+		}
+
+		fprintf(fp, "\\right)");
+	}
+
+	/* mul */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "mul", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, "\\left(");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+
+			fprintf(fp, " \\times ");
+
+			saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[((index - chromo->numInputs) * chromo->arity) + i], fp);
+		}
+
+		fprintf(fp, "\\right)");
+	}
+
+	/* div (change to frac)*/
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "div", FUNCTIONNAMELENGTH) == 0 ) {
+
+		if (getChromosomeNodeArity(chromo, index - chromo->numInputs) == 1) {
+			saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+		}
+		else {
+
+			for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+
+				if (i + 1 < getChromosomeNodeArity(chromo, index - chromo->numInputs)) {
+					fprintf(fp, "\\frac{");
+					saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[((index - chromo->numInputs) * chromo->arity) + i], fp);
+					fprintf(fp, "}{");
+				}
+				else if (i + 1 == getChromosomeNodeArity(chromo, index - chromo->numInputs) && getChromosomeNodeArity(chromo, index - chromo->numInputs) > 2) {
+					saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[((index - chromo->numInputs) * chromo->arity) + i], fp);
+					fprintf(fp, "}}");
+				}
+				else {
+					saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[((index - chromo->numInputs) * chromo->arity) + i], fp);
+					fprintf(fp, "}");
+				}
+			}
+		}
+	}
+
+	/* abs */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "abs", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " \\left|");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " \\right|");
+
+	}
+
+	/* sqrt */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "sqrt", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " \\sqrt{");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " }");
+
+	}
+
+
+	/* sq */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "sq", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " (");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " )^2");
+
+	}
+
+	/* cube */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "cube", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " (");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " )^3");
+
+	}
+
+	/* exp */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "exp", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " e^{");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " }");
+
+	}
+
+	/* sin */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "sin", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, "\\sin(");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " )");
+
+	}
+
+	/* cos */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "cos", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " \\cos(");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " )");
+
+	}
+
+	/* tan */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "tan", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " \\tan(");
+
+		saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[(index - chromo->numInputs) * chromo->arity], fp);
+
+		fprintf(fp, " )");
+
+	}
+
+	/* rand */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "rand", FUNCTIONNAMELENGTH) == 0 ) {
 
 		fprintf(fp, " rand()");
 	}
 
-	/* pi */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "pi", FUNCTIONNAMELENGTH) == 0 ) {
+	/* pi */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "pi", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, "\\pi");
+	}
+
+	/* 0 */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "0", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " 0");
+	}
+
+	/* 1 */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]], "1", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " 1");
+	}
+
+	/* other */
+	else {
+
+		fprintf(fp, "%s(", chromo->funcSet->functionNames[chromo->nodeFunctions[index - chromo->numInputs]]);
+
+		for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+
+			saveChromosomeLatexRecursive(chromo, chromo->nodeInputs[((index - chromo->numInputs) * chromo->arity) + i], fp);
+
+			if (i < getChromosomeNodeArity(chromo, index - chromo->numInputs) - 1)
+				fprintf(fp, ", ");
+		}
+
+		fprintf(fp, ")");
+	}
+
+}
+
+
+/*
+	Mutates the given chromosome using the mutation method described in parameters
+*/
+DLL_EXPORT void mutateChromosome(struct parameters *params, struct chromosome *chromo) {
+
+	params->mutationType(params, chromo);
+
+	setChromosomeActiveNodes(chromo);
+}
+
+
+/*
+	removes the inactive nodes from the given chromosome
+*/
+DLL_EXPORT void removeInactiveNodes(struct chromosome *chromo) {
+
+	int i, j;
+	int numActiveNodes;
+	int nodeIndex;
+	int *newNodeIndex;
+
+	const int numInputs = chromo->numInputs;
+	const int arity = chromo->arity;
+
+	/* set the active nodes */
+	setChromosomeActiveNodes(chromo);
+
+	numActiveNodes = chromo->numActiveNodes;
+
+	/*
+		record the new position of each node once the inactive nodes have been removed;
+		the number of active nodes which precede it. Connections to removed nodes are
+		moved to the next remaining node.
+	*/
+	newNodeIndex = (int*)malloc(chromo->numNodes * sizeof(int));
+
+	for (i = 0, j = 0; i < chromo->numNodes; i++) {
+		newNodeIndex[i] = j;
+		j += chromo->nodeActive[i];
+	}
+
+	/* shuffle the active nodes forward, active nodes are in order so never overwrite an unmoved node */
+	for (i = 0; i < numActiveNodes; i++) {
+
+		nodeIndex = chromo->activeNodes[i];
+
+		chromo->nodeFunctions[i] = chromo->nodeFunctions[nodeIndex];
+		chromo->nodeValues[numInputs + i] = chromo->nodeValues[numInputs + nodeIndex];
+
+		for (j = 0; j < arity; j++) {
+
+			chromo->nodeInputs[(i * arity) + j] = chromo->nodeInputs[(nodeIndex * arity) + j];
+			chromo->nodeWeights[(i * arity) + j] = chromo->nodeWeights[(nodeIndex * arity) + j];
+
+			if (chromo->nodeInputs[(i * arity) + j] >= numInputs) {
+				chromo->nodeInputs[(i * arity) + j] = newNodeIndex[chromo->nodeInputs[(i * arity) + j] - numInputs] + numInputs;
+			}
+		}
+	}
+
+	/* for the number of chromosome outputs */
+	for (j = 0; j < chromo->numOutputs; j++) {
+
+		if (chromo->outputNodes[j] >= numInputs) {
+			chromo->outputNodes[j] = newNodeIndex[chromo->outputNodes[j] - numInputs] + numInputs;
+		}
+	}
+
+	free(newNodeIndex);
+
+	chromo->numNodes = numActiveNodes;
+
+	/* reallocate the memory associated with the chromosome */
+	chromo->nodeFunctions = (int*)realloc(chromo->nodeFunctions, chromo->numNodes * sizeof(int));
+	chromo->nodeInputs = (int*)realloc(chromo->nodeInputs, chromo->numNodes * arity * sizeof(int));
+	chromo->nodeWeights = (double*)realloc(chromo->nodeWeights, chromo->numNodes * arity * sizeof(double));
+	chromo->nodeValues = (double*)realloc(chromo->nodeValues, (numInputs + chromo->numNodes) * sizeof(double));
+	chromo->nodeActive = (int*)realloc(chromo->nodeActive, chromo->numNodes * sizeof(int));
+	chromo->nodeActArity = (int*)realloc(chromo->nodeActArity, chromo->numNodes * sizeof(int));
+	chromo->nodeHashes = (unsigned long long*)realloc(chromo->nodeHashes, chromo->numNodes * sizeof(unsigned long long));
+	chromo->activeNodes = (int*)realloc(chromo->activeNodes, chromo->numNodes * sizeof(int));
+	chromo->planFunctions = realloc(chromo->planFunctions, chromo->numNodes * sizeof(*chromo->planFunctions));
+	chromo->planArity = (int*)realloc(chromo->planArity, chromo->numNodes * sizeof(int));
+	chromo->planOperands = (int*)realloc(chromo->planOperands, chromo->numNodes * arity * sizeof(int));
+	chromo->planWeights = (double*)realloc(chromo->planWeights, chromo->numNodes * arity * sizeof(double));
+	chromo->planBlockFunctions = realloc(chromo->planBlockFunctions, chromo->numNodes * sizeof(*chromo->planBlockFunctions));
+	chromo->planColumns = (int*)realloc(chromo->planColumns, chromo->numNodes * arity * sizeof(int));
+
+	/* set the active nodes */
+	setChromosomeActiveNodes(chromo);
+}
+
+
+/*
+	sets the fitness of the given chromosome
+*/
+DLL_EXPORT void setChromosomeFitness(struct parameters *params, struct chromosome *chromo, struct dataSet *data) {
+
+	setChromosomeFitnessCutoff(params, chromo, data, HUGE_VAL);
+}
+
+
+/*
+	sets the fitness of the given chromosome. The fitness function may stop
+	early and return any fitness greater than the cutoff if the chromosome's
+	fitness is certain to be greater than the cutoff.
+*/
+static void setChromosomeFitnessCutoff(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
+
+	double fitness;
+
+	setChromosomeActiveNodes(chromo);
+
+	resetChromosome(chromo);
+
+	if (chromosomeNeedsCompiling(params, chromo)) {
+		compileChromosome(chromo);
+	}
+
+	if (params->cutoffFitnessFunction != NULL) {
+		fitness = params->cutoffFitnessFunction(params, chromo, data, cutoff);
+	}
+	else {
+		fitness = params->fitnessFunction(params, chromo, data);
+	}
+
+	chromo->fitness = fitness;
+}
+
+
+/*
+	Returns one if the given chromosome should be compiled before being
+	assigned a fitness. The default fitness function executes feed-forward
+	chromosomes a block of samples at a time using the execution plan, so
+	their native code would not be used.
+*/
+static int chromosomeNeedsCompiling(struct parameters *params, struct chromosome *chromo) {
+
+	if (params->compileChromosomes == 0) {
+		return 0;
+	}
+
+	return params->cutoffFitnessFunction != supervisedLearning || chromo->planIsFeedForward == 0;
+}
+
+
+/*
+	reset the output values of all chromosome nodes to zero
+*/
+DLL_EXPORT void resetChromosome(struct chromosome *chromo) {
+
+	memset(chromo->nodeValues + chromo->numInputs, 0, chromo->numNodes * sizeof(double));
+}
+
+/*
+	copies the contents of one chromosome to another. Provided the number of inputs, nodes, outputs and node arity are the same.
+*/
+DLL_EXPORT void copyChromosome(struct chromosome *chromoDest, struct chromosome *chromoSrc) {
+
+	/* error checking  */
+	if (chromoDest->numInputs != chromoSrc->numInputs) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome inputs do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (chromoDest->numNodes != chromoSrc->numNodes) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome nodes do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (chromoDest->numOutputs != chromoSrc->numOutputs) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome outputs do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (chromoDest->arity != chromoSrc->arity) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The arity of the chromosome nodes do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* copy the node genes, which nodes are active and their actual arities */
+	memcpy(chromoDest->nodeFunctions, chromoSrc->nodeFunctions, chromoSrc->numNodes * sizeof(int));
+	memcpy(chromoDest->nodeInputs, chromoSrc->nodeInputs, chromoSrc->numNodes * chromoSrc->arity * sizeof(int));
+	memcpy(chromoDest->nodeWeights, chromoSrc->nodeWeights, chromoSrc->numNodes * chromoSrc->arity * sizeof(double));
+	memcpy(chromoDest->nodeActive, chromoSrc->nodeActive, chromoSrc->numNodes * sizeof(int));
+	memcpy(chromoDest->nodeActArity, chromoSrc->nodeActArity, chromoSrc->numNodes * sizeof(int));
+	memcpy(chromoDest->activeNodes, chromoSrc->activeNodes, chromoSrc->numActiveNodes * sizeof(int));
+
+	/* copy the execution plan */
+	memcpy(chromoDest->planFunctions, chromoSrc->planFunctions, chromoSrc->numActiveNodes * sizeof(*chromoSrc->planFunctions));
+	memcpy(chromoDest->planArity, chromoSrc->planArity, chromoSrc->numActiveNodes * sizeof(int));
+	memcpy(chromoDest->planOperands, chromoSrc->planOperands, chromoSrc->numActiveNodes * chromoSrc->arity * sizeof(int));
+	memcpy(chromoDest->planWeights, chromoSrc->planWeights, chromoSrc->numActiveNodes * chromoSrc->arity * sizeof(double));
+	memcpy(chromoDest->planBlockFunctions, chromoSrc->planBlockFunctions, chromoSrc->numActiveNodes * sizeof(*chromoSrc->planBlockFunctions));
+	memcpy(chromoDest->planColumns, chromoSrc->planColumns, chromoSrc->numActiveNodes * chromoSrc->arity * sizeof(int));
+	memcpy(chromoDest->planOutputColumns, chromoSrc->planOutputColumns, chromoSrc->numOutputs * sizeof(int));
+	chromoDest->planIsFeedForward = chromoSrc->planIsFeedForward;
+	chromoDest->compiledFunction = chromoSrc->compiledFunction;
+	chromoDest->activeHash = chromoSrc->activeHash;
+
+	/* copy functionset */
+	copyFunctionSet(chromoDest->funcSet, chromoSrc->funcSet);
+
+	/* copy each of the chromosomes outputs */
+	memcpy(chromoDest->outputNodes, chromoSrc->outputNodes, chromoSrc->numOutputs * sizeof(int));
+
+	/* copy the number of active node */
+	chromoDest->numActiveNodes = chromoSrc->numActiveNodes;
+
+	/* copy the fitness */
+	chromoDest->fitness = chromoSrc->fitness;
+
+	/* copy generation */
+	chromoDest->generation = chromoSrc->generation;
+
+	/* copy the number of saved evaluations */
+	chromoDest->savedEvaluations = chromoSrc->savedEvaluations;
+}
+
+/*
+	Gets the number of chromosome inputs
+*/
+DLL_EXPORT int getNumChromosomeInputs(struct chromosome *chromo) {
+	return chromo->numInputs;
+}
+
+/*
+	Gets the number of chromosome nodes
+*/
+DLL_EXPORT int getNumChromosomeNodes(struct chromosome *chromo) {
+	return chromo->numNodes;
+}
+
+/*
+	Gets the number of chromosome active nodes
+*/
+DLL_EXPORT int getNumChromosomeActiveNodes(struct chromosome *chromo) {
+	return chromo->numActiveNodes;
+}
+
+/*
+	Gets the number of chromosome outputs
+*/
+DLL_EXPORT int getNumChromosomeOutputs(struct chromosome *chromo) {
+	return chromo->numOutputs;
+}
+
+/*
+	Gets the chromosome node arity
+*/
+DLL_EXPORT int getChromosomeNodeArity(struct chromosome *chromo, int index) {
+
+	int chromoArity = chromo->arity;
+	int maxArity = chromo->funcSet->maxNumInputs[chromo->nodeFunctions[index]];
+
+	if (maxArity == -1) {
+		return chromoArity;
+	}
+	else if (maxArity < chromoArity) {
+		return maxArity;
+	}
+	else {
+		return chromoArity;
+	}
+}
+
+/*
+	Gets the chromosome fitness
+*/
+DLL_EXPORT double getChromosomeFitness(struct chromosome *chromo) {
+	return chromo->fitness;
+}
+
+/*
+	Gets the number of active connections in the given chromosome
+*/
+DLL_EXPORT int getNumChromosomeActiveConnections(struct chromosome *chromo) {
+
+	int i;
+	int complexity = 0;
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		complexity += chromo->nodeActArity[chromo->activeNodes[i]];
+	}
+
+	return complexity;
+}
+
+/*
+	Gets the number of generations required to find the given chromosome
+*/
+DLL_EXPORT int getChromosomeGenerations(struct chromosome *chromo) {
+	return chromo->generation;
+}
+
+
+/*
+	Gets the number of fitness evaluations saved by reusing the fitness
+	of identical chromosomes while finding the given chromosome
+*/
+DLL_EXPORT int getChromosomeSavedEvaluations(struct chromosome *chromo) {
+	return chromo->savedEvaluations;
+}
+
+
+/*
+	set the active nodes in the given chromosome
+*/
+static void setChromosomeActiveNodes(struct chromosome *chromo) {
+
+	int i;
+
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: chromosome has not been initialised and so the active nodes cannot be set.\n");
+		return;
+	}
+
+	/* set the number of active nodes to zero */
+	chromo->numActiveNodes = 0;
+
+	/* reset the active nodes */
+	memset(chromo->nodeActive, 0, chromo->numNodes * sizeof(int));
+
+	/* start the recursive search for active nodes from the output nodes for the number of output nodes */
+	for (i = 0; i < chromo->numOutputs; i++) {
+
+		/* if the output connects to a chromosome input, skip */
+		if (chromo->outputNodes[i] < chromo->numInputs) {
+			continue;
+		}
+
+		/* begin a recursive search for active nodes */
+		recursivelySetActiveNodes(chromo, chromo->outputNodes[i]);
+	}
+
+	/* place active nodes in order */
+	sortIntArray(chromo->activeNodes, chromo->numActiveNodes);
+
+	/* compile the active nodes into the execution plan used by executeChromosome */
+	setChromosomeExecutionPlan(chromo);
+}
+
+
+/*
+	Builds the execution plan of the given chromosome from its active nodes.
+
+	The plan is a linear list of steps, one per active node in execution order,
+	each holding the node function, actual arity, connection weights and the
+	slots of its operands. Operand slots index a single value buffer in which
+	the chromosome inputs are followed by the node outputs, so executeChromosome
+	does not decode connection genes or distinguish inputs from nodes per sample.
+
+	The plan is rebuilt whenever the active nodes are set, i.e. once per genotype
+	change, and reused for every execution until then.
+*/
+static void setChromosomeExecutionPlan(struct chromosome *chromo) {
+
+	int i, j;
+	int nodeIndex;
+	int operand;
+
+	const int arity = chromo->arity;
+	const int numInputs = chromo->numInputs;
+
+	chromo->planIsFeedForward = 1;
+
+	/* any compiled code was for the previous genotype */
+	chromo->compiledFunction = NULL;
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		nodeIndex = chromo->activeNodes[i];
+
+		chromo->planFunctions[i] = chromo->funcSet->functions[chromo->nodeFunctions[nodeIndex]];
+		chromo->planBlockFunctions[i] = chromo->funcSet->blockFunctions[chromo->nodeFunctions[nodeIndex]];
+		chromo->planArity[i] = chromo->nodeActArity[nodeIndex];
+
+		/* connection genes already index the shared input and node value space */
+		for (j = 0; j < arity; j++) {
+
+			operand = chromo->nodeInputs[(nodeIndex * arity) + j];
+
+			chromo->planOperands[(i * arity) + j] = operand;
+			chromo->planWeights[(i * arity) + j] = chromo->nodeWeights[(nodeIndex * arity) + j];
+
+			/* the block columns only exist for used operands */
+			if (j < chromo->planArity[i]) {
+				chromo->planColumns[(i * arity) + j] = getExecutionPlanColumn(chromo, operand);
+			}
+			else {
+				chromo->planColumns[(i * arity) + j] = 0;
+			}
+
+			/* connections to the node itself or later nodes are recurrent */
+			if (j < chromo->planArity[i] && operand >= numInputs + nodeIndex) {
+				chromo->planIsFeedForward = 0;
+			}
+		}
+	}
+
+	for (i = 0; i < chromo->numOutputs; i++) {
+		chromo->planOutputColumns[i] = getExecutionPlanColumn(chromo, chromo->outputNodes[i]);
+	}
+
+	chromo->activeHash = getActiveGenotypeHash(chromo);
+}
+
+
+/*
+	Returns a canonical hash of the active graph of the given chromosome.
+
+	The hash of each active node is built incrementally from its function,
+	the hashes of the inputs and earlier nodes it connects to and, if the
+	node function uses them, its connection weights. The chromosome hash
+	combines the hashes of the nodes or inputs the outputs connect to.
+	Identical graphs therefore have equal hashes regardless of where their
+	nodes lie in the chromosome. Recurrent connections are hashed by the
+	position they connect to.
+*/
+static unsigned long long getActiveGenotypeHash(struct chromosome *chromo) {
+
+	int i, j;
+	int nodeIndex;
+	int nodeArity;
+	int operand;
+	unsigned long long hash;
+
+	const int arity = chromo->arity;
+	const int numInputs = chromo->numInputs;
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		nodeIndex = chromo->activeNodes[i];
+		nodeArity = chromo->planArity[i];
+
+		hash = hashBytes(HASHOFFSETBASIS, &chromo->nodeFunctions[nodeIndex], sizeof(int));
+		hash = hashBytes(hash, &nodeArity, sizeof(int));
+
+		for (j = 0; j < nodeArity; j++) {
+
+			operand = chromo->planOperands[(i * arity) + j];
+
+			if (operand < numInputs + nodeIndex) {
+				hash = hashOperand(chromo, hash, operand);
+			}
+
+			/* recurrent connection */
+			else {
+				hash = hashBytes(hash, "r", 1);
+				hash = hashBytes(hash, &operand, sizeof(int));
+			}
+		}
+
+		if (planStepUsesWeights(chromo, i)) {
+			hash = hashBytes(hash, chromo->planWeights + (i * arity), nodeArity * sizeof(double));
+		}
+
+		chromo->nodeHashes[nodeIndex] = hash;
+	}
+
+	hash = HASHOFFSETBASIS;
+
+	for (i = 0; i < chromo->numOutputs; i++) {
+		hash = hashOperand(chromo, hash, chromo->outputNodes[i]);
+	}
+
+	/* nodes only reached through recurrent connections are not covered by the outputs */
+	if (chromo->planIsFeedForward == 0) {
+
+		for (i = 0; i < chromo->numActiveNodes; i++) {
+			hash = hashBytes(hash, &chromo->activeNodes[i], sizeof(int));
+			hash = hashBytes(hash, &chromo->nodeHashes[chromo->activeNodes[i]], sizeof(unsigned long long));
+		}
+	}
+
+	return hash;
+}
+
+
+/*
+	Continues the given hash with the given chromosome input or
+	the hash of the given earlier active node.
+*/
+static unsigned long long hashOperand(struct chromosome *chromo, unsigned long long hash, int operand) {
+
+	if (operand < chromo->numInputs) {
+		hash = hashBytes(hash, "i", 1);
+		return hashBytes(hash, &operand, sizeof(int));
+	}
+
+	hash = hashBytes(hash, "n", 1);
+	return hashBytes(hash, &chromo->nodeHashes[operand - chromo->numInputs], sizeof(unsigned long long));
+}
+
+
+/*
+	Returns one if the active genotypes of the given chromosomes are equal,
+	so they must be assigned the same fitness by any fitness function which
+	only depends on the chromosomes behaviour. Returns zero otherwise, or if
+	either uses the rand node function as then their outputs differ.
+*/
+static int chromosomesPhenotypicallyEqual(struct chromosome *chromoA, struct chromosome *chromoB) {
+
+	int i;
+	int nodeArity;
+
+	const int arity = chromoA->arity;
+
+	if (chromoA->activeHash != chromoB->activeHash || chromoA->numActiveNodes != chromoB->numActiveNodes) {
+		return 0;
+	}
+
+	if (chromoA->numInputs != chromoB->numInputs || chromoA->numOutputs != chromoB->numOutputs || chromoA->arity != chromoB->arity) {
+		return 0;
+	}
+
+	if (memcmp(chromoA->activeNodes, chromoB->activeNodes, chromoA->numActiveNodes * sizeof(int)) != 0) {
+		return 0;
+	}
+
+	if (memcmp(chromoA->outputNodes, chromoB->outputNodes, chromoA->numOutputs * sizeof(int)) != 0) {
+		return 0;
+	}
+
+	for (i = 0; i < chromoA->numActiveNodes; i++) {
+
+		nodeArity = chromoA->planArity[i];
+
+		if (chromoA->planFunctions[i] != chromoB->planFunctions[i] || chromoA->planFunctions[i] == _randFloat) {
+			return 0;
+		}
+
+		if (nodeArity != chromoB->planArity[i]) {
+			return 0;
+		}
+
+		if (memcmp(chromoA->planOperands + (i * arity), chromoB->planOperands + (i * arity), nodeArity * sizeof(int)) != 0) {
+			return 0;
+		}
+
+		if (planStepUsesWeights(chromoA, i) && memcmp(chromoA->planWeights + (i * arity), chromoB->planWeights + (i * arity), nodeArity * sizeof(double)) != 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+/*
+	Returns zero if the node function of the given execution plan step is a
+	preset which ignores the connection weights, one otherwise. Custom node
+	functions may use the weights.
+*/
+static int planStepUsesWeights(struct chromosome *chromo, int step) {
+
+	double (*function)(const int numInputs, const double *inputs, const double *connectionWeights) = chromo->planFunctions[step];
+
+	if (function == _sigmoid || function == _gaussian || function == _step || function == _softsign || function == _hyperbolicTangent) {
+		return 1;
+	}
+
+	/* only preset node functions have block variants */
+	if (chromo->planBlockFunctions[step] != NULL || function == _randFloat) {
+		return 0;
+	}
+
+	return 1;
+}
+
+
+/*
+	Returns the block column holding the value of the given chromosome
+	input or active node. Block columns hold the chromosome inputs
+	followed by the active nodes in execution order.
+*/
+static int getExecutionPlanColumn(struct chromosome *chromo, int operand) {
+
+	int nodeIndex;
+	int *activeNode;
+
+	if (operand < chromo->numInputs) {
+		return operand;
+	}
+
+	nodeIndex = operand - chromo->numInputs;
+
+	/* active nodes are stored in order */
+	activeNode = (int*)bsearch(&nodeIndex, chromo->activeNodes, chromo->numActiveNodes, sizeof(int), cmpInt);
+
+	return chromo->numInputs + (int)(activeNode - chromo->activeNodes);
+}
+
+
+/*
+	used by setActiveNodes to recursively search for active nodes
+*/
+static void recursivelySetActiveNodes(struct chromosome *chromo, int nodeIndex) {
+
+	int i;
+
+	/* if the given node is an input, stop */
+	if (nodeIndex < chromo->numInputs) {
+		return;
+	}
+
+	/* if the given node has already been flagged as active */
+	if (chromo->nodeActive[nodeIndex - chromo->numInputs] == 1) {
+		return;
+	}
+
+	/* log the node as active */
+	chromo->nodeActive[nodeIndex - chromo->numInputs] = 1;
+	chromo->activeNodes[chromo->numActiveNodes] = nodeIndex - chromo->numInputs;
+	chromo->numActiveNodes++;
+
+	/* set the nodes actual arity*/
+	chromo->nodeActArity[nodeIndex - chromo->numInputs] = getChromosomeNodeArity(chromo, nodeIndex - chromo->numInputs);
+
+	/* recursively log all the nodes to which the current nodes connect as active */
+	for (i = 0; i < chromo->nodeActArity[nodeIndex - chromo->numInputs]; i++) {
+		recursivelySetActiveNodes(chromo, chromo->nodeInputs[((nodeIndex - chromo->numInputs) * chromo->arity) + i]);
+	}
+}
+
+
+/*
+	Sets ranking to the indices of the given chromosomes ordered by fitness,
+	lowest to highest. Chromosomes of equal fitness keep their order in the
+	array. Uses a bottom up merge sort, O(n log n) and stable.
+*/
+DLL_EXPORT void getChromosomeRanking(struct chromosome **chromoArray, int numChromos, int *ranking) {
+
+	int i;
+	int *buffer;
+
+	for (i = 0; i < numChromos; i++) {
+		ranking[i] = i;
+	}
+
+	buffer = (int*)malloc(numChromos * sizeof(int));
+
+	mergeSortChromosomeIndices(chromoArray, ranking, buffer, numChromos);
+
+	free(buffer);
+}
+
+
+/*
+	Stable merge sort of the given indices into chromoArray by fitness,
+	lowest to highest. buffer must hold numIndices values.
+*/
+static void mergeSortChromosomeIndices(struct chromosome **chromoArray, int *indices, int *buffer, int numIndices) {
+
+	int width;
+	int start, middle, end;
+	int i, j, k;
+
+	for (width = 1; width < numIndices; width *= 2) {
+
+		for (start = 0; start < numIndices; start += 2 * width) {
+
+			middle = start + width < numIndices ? start + width : numIndices;
+			end = start + (2 * width) < numIndices ? start + (2 * width) : numIndices;
+
+			i = start;
+			j = middle;
+			k = start;
+
+			/* take from the right run only if strictly fitter, keeping equal chromosomes in order */
+			while (i < middle && j < end) {
+
+				if (chromoArray[indices[j]]->fitness < chromoArray[indices[i]]->fitness) {
+					buffer[k++] = indices[j++];
+				}
+				else {
+					buffer[k++] = indices[i++];
+				}
+			}
+
+			while (i < middle) {
+				buffer[k++] = indices[i++];
+			}
+
+			while (j < end) {
+				buffer[k++] = indices[j++];
+			}
+		}
+
+		memcpy(indices, buffer, numIndices * sizeof(int));
+	}
+}
+
+
+/*
+	Sets fittest to the indices of the numFittest fittest of the given
+	chromosomes, in the order given by getChromosomeRanking. Only the
+	fittest are kept, in a heap whose root is the one which ranks lowest,
+	so this is O(n log numFittest).
+*/
+static void getFittestChromosomeIndices(struct chromosome **chromoArray, int numChromos, int *fittest, int numFittest) {
+
+	int i;
+	int heapSize;
+	int position;
+	int parent;
+	int tmp;
+
+	if (numFittest > numChromos) {
+		numFittest = numChromos;
+	}
+
+	if (numFittest <= 0) {
+		return;
+	}
+
+	heapSize = 0;
+
+	for (i = 0; i < numChromos; i++) {
+
+		/* add to the heap, moving up past the fitter chromosomes */
+		if (heapSize < numFittest) {
+
+			position = heapSize;
+			fittest[position] = i;
+			heapSize++;
+
+			while (position > 0) {
+
+				parent = (position - 1) / 2;
+
+				if (chromosomeRanksBelow(chromoArray, fittest[parent], fittest[position]) == 1) {
+					break;
+				}
+
+				tmp = fittest[parent];
+				fittest[parent] = fittest[position];
+				fittest[position] = tmp;
+				position = parent;
+			}
+		}
+
+		/* replace the lowest ranked of the fittest found so far */
+		else if (chromosomeRanksBelow(chromoArray, fittest[0], i) == 1) {
+			fittest[0] = i;
+			siftDownFittestHeap(chromoArray, fittest, heapSize, 0);
+		}
+	}
+
+	/* heap sort, moving the lowest ranked to the end */
+	while (heapSize > 1) {
+
+		heapSize--;
+
+		tmp = fittest[0];
+		fittest[0] = fittest[heapSize];
+		fittest[heapSize] = tmp;
+
+		siftDownFittestHeap(chromoArray, fittest, heapSize, 0);
+	}
+}
+
+
+/*
+	Returns one if the chromosome at index ranks below the chromosome at
+	otherIndex; that is it is less fit or equally fit and later in the array.
+*/
+static int chromosomeRanksBelow(struct chromosome **chromoArray, int index, int otherIndex) {
+
+	if (chromoArray[index]->fitness > chromoArray[otherIndex]->fitness) {
+		return 1;
+	}
+
+	if (chromoArray[index]->fitness < chromoArray[otherIndex]->fitness) {
+		return 0;
+	}
+
+	return index > otherIndex;
+}
+
+
+/*
+	Moves the index at the given position of the heap used by
+	getFittestChromosomeIndices down until it ranks below its parent.
+*/
+static void siftDownFittestHeap(struct chromosome **chromoArray, int *heap, int heapSize, int position) {
+
+	int child;
+	int tmp;
+
+	while ((2 * position) + 1 < heapSize) {
+
+		child = (2 * position) + 1;
+
+		/* the lower ranked of the two children */
+		if (child + 1 < heapSize && chromosomeRanksBelow(chromoArray, heap[child + 1], heap[child]) == 1) {
+			child++;
+		}
+
+		if (chromosomeRanksBelow(chromoArray, heap[position], heap[child]) == 1) {
+			break;
+		}
+
+		tmp = heap[position];
+		heap[position] = heap[child];
+		heap[child] = tmp;
+		position = child;
+	}
+}
+
+
+
+/*
+	Dataset functions
+*/
+
+
+/*
+	Initialises data structure and assigns values for given arrays
+	arrays must take the form
+	inputs[numSamples][numInputs]
+	outputs[numSamples][numOutputs]
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromArrays(int numInputs, int numOutputs, int numSamples, double *inputs, double *outputs) {
+
+	struct dataSet *data;
+
+	/* initialise memory for data structure */
+	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	data->numInputs = numInputs;
+	data->numOutputs = numOutputs;
+	data->numSamples = numSamples;
+
+	allocateDataSet(data);
+
+	memcpy(data->inputValues, inputs, (size_t)data->numSamples * data->numInputs * sizeof(double));
+	memcpy(data->outputValues, outputs, (size_t)data->numSamples * data->numOutputs * sizeof(double));
+
+	setDataSetBits(data);
+
+	return data;
+}
+
+
+/*
+	Initialises a dataSet which refers to the given arrays rather than
+	copying them. Sample i is row samples[i] of the arrays, or row i if
+	samples is NULL, and the rows of the inputs and outputs are inputStride
+	and outputStride doubles apart. The arrays must outlive the dataSet.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetView(int numInputs, int numOutputs, int numSamples, double *inputs, int inputStride, double *outputs, int outputStride, const int *samples) {
+
+	int i;
+	size_t row;
+	struct dataSet *data;
+
+	/* error checking */
+	if (inputStride < numInputs || outputStride < numOutputs) {
+		printf("Error: the input stride (%d) and output stride (%d) must be at least the number of inputs (%d) and outputs (%d) respectively.\nTerminating CGP-Library.\n", inputStride, outputStride, numInputs, numOutputs);
+		exit(0);
+	}
+
+	/* initialise memory for data structure */
+	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	data->numInputs = numInputs;
+	data->numOutputs = numOutputs;
+	data->numSamples = numSamples;
+
+	/* the values are not owned by the dataSet */
+	data->inputValues = NULL;
+	data->outputValues = NULL;
+
+	data->inputData = (double**)malloc(data->numSamples * sizeof(double*));
+	data->outputData = (double**)malloc(data->numSamples * sizeof(double*));
+
+	for (i = 0; i < data->numSamples; i++) {
+
+		row = samples == NULL ? (size_t)i : (size_t)samples[i];
+
+		data->inputData[i] = inputs + (row * inputStride);
+		data->outputData[i] = outputs + (row * outputStride);
+	}
+
+	data->inputColumns = NULL;
+	data->outputColumns = NULL;
+	data->columnStride = 0;
+	data->inputFloats = NULL;
+	data->mapping = NULL;
+	data->mappingSize = 0;
+	data->stream = NULL;
+
+	setDataSetBits(data);
+
+	return data;
+}
+
+
+/*
+	sets the number of threads used to parse text dataSet files
+*/
+DLL_EXPORT void setDataSetParsingThreads(int numThreads) {
+
+	/* error checking */
+	if (numThreads < 1) {
+		printf("Warning: the number of dataSet parsing threads cannot be less than one; %d is invalid. The number of dataSet parsing threads is left unchanged as %d.\n", numThreads, dataSetParsingThreads);
+		return;
+	}
+
+	dataSetParsingThreads = numThreads;
+}
+
+
+/*
+	Initialises data structure and assigns values of given file. The whole
+	file is read, or memory mapped, and split into chunks of whole lines
+	which are parsed in parallel using the number of threads set using
+	setDataSetParsingThreads.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromFile(char const *file) {
+
+	int i;
+	int numChunks;
+	int numRows;
+	int rows;
+	int badRow = -1;
+	int badRowValues = 0;
+	int isMapped;
+	size_t size;
+	size_t headerLength;
+	char *contents;
+	char header[256];
+	const char *body;
+	const char *end;
+	const char *newline;
+	const char **chunkStarts;
+	int *chunkRows;
+	struct dataSet *data;
+
+	/* binary dataSet files are loaded without parsing, which reports unreadable versions and byte orders */
+	if (isBinaryDataSetFile(file)) {
+		return initialiseDataSetFromBinaryFile(file);
+	}
+
+	contents = getFileContents(file, &size, &isMapped);
+
+	/* if the file cannot be found */
+	if (contents == NULL) {
+		printf("Error: file '%s' cannot be found.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	end = contents + size;
+
+	/* the first line contains the meta data */
+	newline = (const char*)memchr(contents, '\n', size);
+	body = newline == NULL ? end : newline + 1;
+
+	headerLength = (size_t)(body - contents) < sizeof(header) - 1 ? (size_t)(body - contents) : sizeof(header) - 1;
+	memcpy(header, contents, headerLength);
+	header[headerLength] = '\0';
+
+	/* initialise memory for data structure */
+	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	if (sscanf(header, "%d,%d,%d", &(data->numInputs), &(data->numOutputs), &(data->numSamples)) != 3 || data->numInputs < 0 || data->numOutputs < 0 || data->numSamples < 0) {
+		printf("Error: the first line of file '%s' must give the number of inputs, outputs and samples.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	allocateDataSet(data);
+
+	/* split the other lines, which contain input output pairs, into chunks */
+	numChunks = (int)((size_t)(end - body) / PARSECHUNKSIZE) + 1;
+
+	chunkStarts = (const char**)malloc((numChunks + 1) * sizeof(*chunkStarts));
+	chunkRows = (int*)malloc(numChunks * sizeof(int));
+
+	chunkStarts[0] = body;
+	chunkStarts[numChunks] = end;
+
+	for (i = 1; i < numChunks; i++) {
+		newline = (const char*)memchr(body + ((size_t)i * PARSECHUNKSIZE), '\n', (size_t)(end - body) - ((size_t)i * PARSECHUNKSIZE));
+		chunkStarts[i] = newline == NULL ? end : newline + 1;
+	}
+
+	/* count the samples in each chunk */
+	#pragma omp parallel for default(none), shared(numChunks,chunkStarts,chunkRows), schedule(dynamic), num_threads(dataSetParsingThreads), if(numChunks > 1)
+	for (i = 0; i < numChunks; i++) {
+		chunkRows[i] = countDataSetLines(chunkStarts[i], chunkStarts[i + 1]);
+	}
+
+	/* the first sample of each chunk */
+	numRows = 0;
+
+	for (i = 0; i < numChunks; i++) {
+		rows = chunkRows[i];
+		chunkRows[i] = numRows;
+		numRows += rows;
+	}
+
+	if (numRows != data->numSamples) {
+		printf("Error: file '%s' states it contains %d samples but contains %d.\nTerminating CGP-Library.\n", file, data->numSamples, numRows);
+		exit(0);
+	}
+
+	/* parse the samples of each chunk, keeping the first with the wrong number of values */
+	#pragma omp parallel for default(none), shared(numChunks,chunkStarts,chunkRows,data,badRow,badRowValues), schedule(dynamic), num_threads(dataSetParsingThreads), if(numChunks > 1)
+	for (i = 0; i < numChunks; i++) {
+
+		int chunkBadRowValues;
+		int chunkBadRow = parseDataSetLines(data, chunkStarts[i], chunkStarts[i + 1], chunkRows[i], &chunkBadRowValues);
+
+		if (chunkBadRow != -1) {
+
+			#pragma omp critical (parseDataSet)
+			{
+				if (badRow == -1 || chunkBadRow < badRow) {
+					badRow = chunkBadRow;
+					badRowValues = chunkBadRowValues;
+				}
+			}
+		}
+	}
+
+	if (badRow != -1) {
+		printf("Error: sample %d of file '%s' has %d values; %d inputs and %d outputs were expected.\nTerminating CGP-Library.\n", badRow, file, badRowValues, data->numInputs, data->numOutputs);
+		exit(0);
+	}
+
+	free(chunkStarts);
+	free(chunkRows);
+	releaseFileContents(contents, size, isMapped);
+
+	setDataSetBits(data);
+
+	return data;
+}
+
+
+/*
+	Returns the contents of the given file, memory mapped where possible and
+	otherwise read, and sets size to its length in bytes. The contents are
+	not terminated. Returns NULL if the file cannot be opened.
+*/
+static char *getFileContents(char const *file, size_t *size, int *isMapped) {
+
+	FILE *fp;
+	long fileSize;
+	char *contents;
+
+	fp = fopen(file, "rb");
+
+	if (fp == NULL) {
+		return NULL;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	fileSize = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	*size = fileSize > 0 ? (size_t)fileSize : 0;
+	*isMapped = 0;
+
+#ifdef MEMORYMAPPING
+	if (*size > 0) {
+
+		contents = (char*)mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+
+		if (contents != MAP_FAILED) {
+			fclose(fp);
+			*isMapped = 1;
+			return contents;
+		}
+	}
+#endif
+
+	contents = (char*)malloc(*size + 1);
+	*size = fread(contents, 1, *size, fp);
+
+	fclose(fp);
+
+	return contents;
+}
+
+
+/*
+	Releases file contents returned by getFileContents
+*/
+static void releaseFileContents(char *contents, size_t size, int isMapped) {
+
+#ifdef MEMORYMAPPING
+	if (isMapped) {
+		munmap(contents, size);
+		return;
+	}
+#else
+	(void)size;
+	(void)isMapped;
+#endif
+
+	free(contents);
+}
+
+
+/*
+	Returns one if the given character separates the values of a dataSet file
+*/
+static int isDataSetSeparator(char character) {
+	return character == ',' || character == ' ' || character == '\t' || character == '\r';
+}
+
+
+/*
+	Returns the number of lines between start and end which contain at
+	least one value. end is the start of a line or the end of the file.
+*/
+static int countDataSetLines(const char *start, const char *end) {
+
+	int numLines = 0;
+	int hasValue = 0;
+	const char *character;
+
+	for (character = start; character < end; character++) {
+
+		if (*character == '\n') {
+			numLines += hasValue;
+			hasValue = 0;
+		}
+		else if (hasValue == 0 && isDataSetSeparator(*character) == 0) {
+			hasValue = 1;
+		}
+	}
+
+	return numLines + hasValue;
+}
+
+
+/*
+	Parses the lines between start and end into the samples of the given
+	dataSet starting at the given sample, skipping lines without values.
+	Returns the first sample without one value for each input and output,
+	setting numValues to its number of values, or -1 if there is none.
+*/
+static int parseDataSetLines(struct dataSet *data, const char *start, const char *end, int sample, int *numValues) {
+
+	int values;
+	int badSample = -1;
+	const char *line;
+	const char *lineEnd;
+	const char *token;
+	const char *character;
+
+	const int numInputs = data->numInputs;
+	const int numValuesExpected = data->numInputs + data->numOutputs;
+
+	for (line = start; line < end; line = lineEnd + 1) {
+
+		lineEnd = (const char*)memchr(line, '\n', (size_t)(end - line));
+
+		if (lineEnd == NULL) {
+			lineEnd = end;
+		}
+
+		values = 0;
+		character = line;
+
+		while (1) {
+
+			while (character < lineEnd && isDataSetSeparator(*character)) {
+				character++;
+			}
+
+			if (character == lineEnd) {
+				break;
+			}
+
+			token = character;
+
+			while (character < lineEnd && isDataSetSeparator(*character) == 0) {
+				character++;
+			}
+
+			if (values < numInputs) {
+				data->inputData[sample][values] = parseDouble(token, character);
+			}
+			else if (values < numValuesExpected) {
+				data->outputData[sample][values - numInputs] = parseDouble(token, character);
+			}
+
+			values++;
+		}
+
+		/* lines without values are not samples */
+		if (values == 0) {
+			continue;
+		}
+
+		if (values != numValuesExpected && badSample == -1) {
+			badSample = sample;
+			*numValues = values;
+		}
+
+		sample++;
+	}
+
+	return badSample;
+}
+
+
+/*
+	Returns the value of the number between token and tokenEnd, as atof.
+	Decimal numbers of at most 19 significant digits, whose digits form an
+	integer no greater than 2^53 and whose power of ten is at most 22 in
+	magnitude, are converted with one correctly rounded multiplication or
+	division; all others are converted by strtod.
+*/
+static double parseDouble(const char *token, const char *tokenEnd) {
+
+	static const double powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	const char *character = token;
+	unsigned long long mantissa = 0;
+	int numDigits = 0;
+	int hasDigits = 0;
+	int exponent = 0;
+	int exponentValue = 0;
+	int exponentNegative = 0;
+	int negative = 0;
+	double value;
+	char buffer[64];
+	char *copy;
+	size_t length;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+
+	if (character < tokenEnd && (*character == '-' || *character == '+')) {
+		negative = *character == '-';
+		character++;
+	}
+
+	/* the integer part */
+	while (character < tokenEnd && *character >= '0' && *character <= '9') {
+
+		if (mantissa != 0 || *character != '0') {
+			numDigits++;
+		}
+
+		mantissa = (mantissa * 10) + (unsigned long long)(*character - '0');
+		hasDigits = 1;
+		character++;
+
+		if (numDigits > 19) {
+			goto slowPath;
+		}
+	}
+
+	/* the fractional part */
+	if (character < tokenEnd && *character == '.') {
+
+		character++;
+
+		while (character < tokenEnd && *character >= '0' && *character <= '9') {
+
+			if (mantissa != 0 || *character != '0') {
+				numDigits++;
+			}
+
+			mantissa = (mantissa * 10) + (unsigned long long)(*character - '0');
+			exponent--;
+			hasDigits = 1;
+			character++;
+
+			if (numDigits > 19) {
+				goto slowPath;
+			}
+		}
+	}
+
+	if (hasDigits == 0) {
+		goto slowPath;
+	}
+
+	/* the exponent */
+	if (character < tokenEnd && (*character == 'e' || *character == 'E')) {
+
+		character++;
+
+		if (character < tokenEnd && (*character == '-' || *character == '+')) {
+			exponentNegative = *character == '-';
+			character++;
+		}
+
+		if (character == tokenEnd || *character < '0' || *character > '9') {
+			goto slowPath;
+		}
+
+		while (character < tokenEnd && *character >= '0' && *character <= '9') {
+
+			if (exponentValue < 10000) {
+				exponentValue = (exponentValue * 10) + (*character - '0');
+			}
+
+			character++;
+		}
+	}
+
+	exponent += exponentNegative ? -exponentValue : exponentValue;
+
+	if (character == tokenEnd && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+
+		value = (double)mantissa;
+
+		if (exponent < 0) {
+			value = value / powersOfTen[-exponent];
+		}
+		else {
+			value = value * powersOfTen[exponent];
+		}
+
+		return negative ? -value : value;
+	}
+
+slowPath:
+
+#endif
+
+	length = (size_t)(tokenEnd - token);
+	copy = length < sizeof(buffer) ? buffer : (char*)malloc(length + 1);
+
+	memcpy(copy, token, length);
+	copy[length] = '\0';
+
+	value = strtod(copy, NULL);
+
+	if (copy != buffer) {
+		free(copy);
+	}
+
+	return value;
+}
+
+
+/*
+	Allocates the values of the given dataSet, whose dimensions are set, as
+	one aligned row-major buffer each for the inputs and outputs, and the
+	row pointers into them. The dataSet starts in the row layout.
+*/
+static void allocateDataSet(struct dataSet *data) {
+
+	int i;
+
+	data->inputValues = (double*)mallocAligned((size_t)data->numSamples * data->numInputs * sizeof(double));
+	data->outputValues = (double*)mallocAligned((size_t)data->numSamples * data->numOutputs * sizeof(double));
+
+	data->inputData = (double**)malloc(data->numSamples * sizeof(double*));
+	data->outputData = (double**)malloc(data->numSamples * sizeof(double*));
+
+	for (i = 0; i < data->numSamples; i++) {
+		data->inputData[i] = data->inputValues + ((size_t)i * data->numInputs);
+		data->outputData[i] = data->outputValues + ((size_t)i * data->numOutputs);
+	}
+
+	data->inputColumns = NULL;
+	data->outputColumns = NULL;
+	data->columnStride = 0;
+	data->inputBits = NULL;
+	data->outputBits = NULL;
+	data->inputFloats = NULL;
+	data->mapping = NULL;
+	data->mappingSize = 0;
+	data->stream = NULL;
+}
+
+
+/*
+	Allocates the given number of bytes aligned to DATASETALIGNMENT bytes.
+	The memory must be freed using freeAligned. Failing to allocate the
+	memory is an error, as the dataSet cannot be stored.
+*/
+static void *mallocAligned(size_t size) {
+
+	void *ptr;
+
+#ifdef _WIN32
+	ptr = _aligned_malloc(size, DATASETALIGNMENT);
+#else
+	if (posix_memalign(&ptr, DATASETALIGNMENT, size) != 0) {
+		ptr = NULL;
+	}
+#endif
+
+	if (ptr == NULL && size > 0) {
+		printf("Error: %lu bytes of memory could not be allocated for the dataSet.\nTerminating CGP-Library.\n", (unsigned long)size);
+		exit(0);
+	}
+
+	return ptr;
+}
+
+
+/*
+	Frees memory allocated using mallocAligned
+*/
+static void freeAligned(void *ptr) {
+
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+
+/*
+	Sets the layout of the given dataSet, "row" or "column". In the column
+	layout the inputs and outputs are also stored column by column, each
+	column aligned and padded to a multiple of DATASETALIGNMENT bytes.
+*/
+DLL_EXPORT void setDataSetLayout(struct dataSet *data, char const *layout) {
+
+	int i, j;
+	int columnStride;
+
+	if (data->stream != NULL) {
+		printf("\nWarning: a streamed dataSet has no layout. The layout has been left unchanged.\n");
+		return;
+	}
+
+	if (strcmp(layout, "row") == 0) {
+		freeAligned(data->inputColumns);
+		freeAligned(data->outputColumns);
+		data->inputColumns = NULL;
+		data->outputColumns = NULL;
+		data->columnStride = 0;
+	}
+	else if (strcmp(layout, "column") == 0) {
+
+		if (data->inputColumns != NULL) {
+			return;
+		}
+
+		columnStride = (int)(((data->numSamples + (DATASETALIGNMENT / sizeof(double)) - 1) / (DATASETALIGNMENT / sizeof(double))) * (DATASETALIGNMENT / sizeof(double)));
+
+		data->inputColumns = (double*)mallocAligned((size_t)columnStride * data->numInputs * sizeof(double));
+		data->outputColumns = (double*)mallocAligned((size_t)columnStride * data->numOutputs * sizeof(double));
+		data->columnStride = columnStride;
+
+		for (i = 0; i < data->numSamples; i++) {
+
+			for (j = 0; j < data->numInputs; j++) {
+				data->inputColumns[((size_t)j * columnStride) + i] = data->inputData[i][j];
+			}
+
+			for (j = 0; j < data->numOutputs; j++) {
+				data->outputColumns[((size_t)j * columnStride) + i] = data->outputData[i][j];
+			}
+		}
+	}
+	else {
+		printf("\nWarning: dataSet layout '%s' is invalid. The layout must be 'row' or 'column'. The layout has been left unchanged as '%s'.\n", layout, data->inputColumns != NULL ? "column" : "row");
+	}
+}
+
+
+/*
+	Initialises a dataSet from a binary dataSet file written by
+	saveDataSetBinary. Where possible the file is memory mapped and used
+	in place, privately so changes to the values are not written back.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromBinaryFile(char const *file) {
+
+	int i;
+	FILE *fp;
+	long fileSize;
+	size_t inputsSize;
+	size_t outputsSize;
+	unsigned char *values;
+	struct binaryDataSetHeader header;
+	struct dataSet *data;
+
+	fp = fopen(file, "rb");
+
+	if (fp == NULL) {
+		printf("Error: file '%s' cannot be found.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	readBinaryDataSetHeader(fp, file, &header, &fileSize);
+
+	inputsSize = (size_t)header.numSamples * header.numInputs * sizeof(double);
+	outputsSize = (size_t)header.numSamples * header.numOutputs * sizeof(double);
+
+	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	data->numInputs = header.numInputs;
+	data->numOutputs = header.numOutputs;
+	data->numSamples = (int)header.numSamples;
+
+#ifdef MEMORYMAPPING
+	values = (unsigned char*)mmap(NULL, (size_t)fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(fp), 0);
+
+	if (values != MAP_FAILED) {
+
+		fclose(fp);
+
+		data->inputValues = NULL;
+		data->outputValues = NULL;
+
+		data->inputData = (double**)malloc(data->numSamples * sizeof(double*));
+		data->outputData = (double**)malloc(data->numSamples * sizeof(double*));
+
+		for (i = 0; i < data->numSamples; i++) {
+			data->inputData[i] = (double*)(values + header.inputsOffset) + ((size_t)i * data->numInputs);
+			data->outputData[i] = (double*)(values + header.outputsOffset) + ((size_t)i * data->numOutputs);
+		}
+
+		data->inputColumns = NULL;
+		data->outputColumns = NULL;
+		data->columnStride = 0;
+		data->inputFloats = NULL;
+		data->mapping = values;
+		data->mappingSize = (size_t)fileSize;
+		data->stream = NULL;
+
+		setBinaryDataSetBits(data, header.flags);
+
+		return data;
+	}
+#endif
+
+	/* otherwise the values are read */
+	allocateDataSet(data);
+
+	fseek(fp, (long)header.inputsOffset, SEEK_SET);
+	values = (unsigned char*)data->inputValues;
+
+	if (fread(values, 1, inputsSize, fp) != inputsSize) {
+		printf("Error: binary dataSet file '%s' could not be read.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	fseek(fp, (long)header.outputsOffset, SEEK_SET);
+	values = (unsigned char*)data->outputValues;
+
+	if (fread(values, 1, outputsSize, fp) != outputsSize) {
+		printf("Error: binary dataSet file '%s' could not be read.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	fclose(fp);
+
+	setBinaryDataSetBits(data, header.flags);
+
+	return data;
+}
+
+
+/*
+	Sets the bit packed copy of a dataSet loaded from a binary file, using
+	the flags saved in its header rather than checking every value where
+	they were saved
+*/
+static void setBinaryDataSetBits(struct dataSet *data, uint32_t flags) {
+
+	if ((flags & BINARYDATASETCHECKED) == 0) {
+		setDataSetBits(data);
+		return;
+	}
+
+	data->inputBits = NULL;
+	data->outputBits = NULL;
+
+	if ((flags & BINARYDATASETBOOLEAN) != 0) {
+		packDataSetBits(data);
+	}
+}
+
+
+/*
+	Reads and checks the header of the given open binary dataSet file,
+	setting fileSize to the length of the file in bytes
+*/
+static void readBinaryDataSetHeader(FILE *fp, char const *file, struct binaryDataSetHeader *header, long *fileSize) {
+
+	int corrupt;
+	size_t inputsSize;
+	size_t outputsSize;
+
+	if (fread(header, sizeof(*header), 1, fp) != 1 || memcmp(header->magic, "CGPDATA", 8) != 0) {
+		printf("Error: file '%s' is not a binary dataSet file.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	if (header->byteOrder != BINARYDATASETBYTEORDER) {
+		printf("Error: binary dataSet file '%s' was written with a different byte order.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	if (header->version > BINARYDATASETVERSION) {
+		printf("Error: binary dataSet file '%s' is version %u; this CGP-Library reads versions up to %d.\nTerminating CGP-Library.\n", file, (unsigned int)header->version, BINARYDATASETVERSION);
+		exit(0);
+	}
+
+	fseek(fp, 0, SEEK_END);
+	*fileSize = ftell(fp);
+
+	if (*fileSize < 0 || header->numInputs < 0 || header->numOutputs < 0 || header->numSamples > INT32_MAX) {
+		corrupt = 1;
+	}
+
+	/* the sizes of the inputs and outputs must not overflow */
+	else if ((header->numInputs > 0 && header->numSamples > SIZE_MAX / sizeof(double) / (size_t)header->numInputs) || (header->numOutputs > 0 && header->numSamples > SIZE_MAX / sizeof(double) / (size_t)header->numOutputs)) {
+		corrupt = 1;
+	}
+
+	/* and must lie within the file, in order, without the offsets overflowing */
+	else {
+
+		inputsSize = (size_t)header->numSamples * header->numInputs * sizeof(double);
+		outputsSize = (size_t)header->numSamples * header->numOutputs * sizeof(double);
+
+		corrupt = header->inputsOffset < sizeof(*header) || header->inputsOffset > (uint64_t)*fileSize || inputsSize > (uint64_t)*fileSize - header->inputsOffset;
+		corrupt = corrupt || header->outputsOffset < header->inputsOffset + inputsSize || header->outputsOffset > (uint64_t)*fileSize || outputsSize > (uint64_t)*fileSize - header->outputsOffset;
+		corrupt = corrupt || header->inputsOffset % sizeof(double) != 0 || header->outputsOffset % sizeof(double) != 0;
+	}
+
+	if (corrupt) {
+		printf("Error: binary dataSet file '%s' is corrupt.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+}
+
+
+/*
+	Initialises a dataSet which streams the samples of the given binary
+	dataSet file from disk, blockSize samples at a time, rather than
+	holding them in memory.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetStream(char const *file, int blockSize) {
+
+	FILE *fp;
+	long fileSize;
+	struct binaryDataSetHeader header;
+	struct dataSet *data;
+
+	/* the total number of streamed dataSets, giving each its own id */
+	static unsigned long long numStreams = 0;
+
+	if (blockSize < 1) {
+		printf("Error: the block size of a streamed dataSet must be at least 1; %d is invalid.\nTerminating CGP-Library.\n", blockSize);
+		exit(0);
+	}
+
+	fp = fopen(file, "rb");
+
+	if (fp == NULL) {
+		printf("Error: file '%s' cannot be found.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	readBinaryDataSetHeader(fp, file, &header, &fileSize);
+
+	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	data->numInputs = header.numInputs;
+	data->numOutputs = header.numOutputs;
+	data->numSamples = (int)header.numSamples;
+
+	/* no samples are held in memory */
+	data->inputValues = NULL;
+	data->outputValues = NULL;
+	data->inputData = NULL;
+	data->outputData = NULL;
+	data->inputColumns = NULL;
+	data->outputColumns = NULL;
+	data->columnStride = 0;
+	data->inputBits = NULL;
+	data->outputBits = NULL;
+	data->inputFloats = NULL;
+	data->mapping = NULL;
+	data->mappingSize = 0;
+
+	/* blocks are whole sample blocks so early rejection matches an in-memory dataSet */
+	data->stream = fp;
+	data->streamBlockSize = ((blockSize + SAMPLEBLOCKSIZE - 1) / SAMPLEBLOCKSIZE) * SAMPLEBLOCKSIZE;
+	data->streamInputsOffset = header.inputsOffset;
+	data->streamOutputsOffset = header.outputsOffset;
+	data->accessedBlocks = NULL;
+
+	#pragma omp critical (dataSetStream)
+	{
+		numStreams++;
+		data->streamId = numStreams;
+	}
+
+	return data;
+}
+
+
+/*
+	The block of the streamed dataSet last accessed by each thread through
+	the sample accessors, and the id of that dataSet. The block is owned by
+	the dataSet and is only used while the ids match; ids are never reused
+	so a freed dataSet's block is never used.
+*/
+static struct dataSetBlock *accessedBlock = NULL;
+static unsigned long long accessedStreamId = 0;
+#pragma omp threadprivate(accessedBlock, accessedStreamId)
+
+
+/*
+	Allocates a block of the given streamed dataSet. No samples are read
+	until readDataSetBlock is called.
+*/
+static void initialiseDataSetBlock(struct dataSet *data, struct dataSetBlock *block) {
+
+	int i;
+	int numRows;
+
+	numRows = data->numSamples < data->streamBlockSize ? data->numSamples : data->streamBlockSize;
+
+	if (numRows < 1) {
+		numRows = 1;
+	}
+
+	block->block = -1;
+	block->firstSample = 0;
+	block->values = (double*)mallocAligned((size_t)numRows * (data->numInputs + data->numOutputs) * sizeof(double));
+
+	block->view.numInputs = data->numInputs;
+	block->view.numOutputs = data->numOutputs;
+	block->view.numSamples = 0;
+	block->view.inputValues = NULL;
+	block->view.outputValues = NULL;
+	block->view.inputData = (double**)malloc(numRows * sizeof(double*));
+	block->view.outputData = (double**)malloc(numRows * sizeof(double*));
+	block->view.inputColumns = NULL;
+	block->view.outputColumns = NULL;
+	block->view.columnStride = 0;
+	block->view.inputBits = NULL;
+	block->view.outputBits = NULL;
+	block->view.inputFloats = NULL;
+	block->view.mapping = NULL;
+	block->view.mappingSize = 0;
+	block->view.stream = NULL;
+
+	/* the inputs of all the samples followed by the outputs, as the file */
+	for (i = 0; i < numRows; i++) {
+		block->view.inputData[i] = block->values + ((size_t)i * data->numInputs);
+		block->view.outputData[i] = block->values + ((size_t)numRows * data->numInputs) + ((size_t)i * data->numOutputs);
+	}
+}
+
+
+/*
+	Frees the memory of the given dataSet block
+*/
+static void freeDataSetBlock(struct dataSetBlock *block) {
+
+	freeAligned(block->values);
+	free(block->view.inputData);
+	free(block->view.outputData);
+
+	block->values = NULL;
+	block->view.inputData = NULL;
+	block->view.outputData = NULL;
+}
+
+
+/*
+	Returns the number of blocks of the given streamed dataSet
+*/
+static int getNumDataSetBlocks(struct dataSet *data) {
+
+	return (data->numSamples + data->streamBlockSize - 1) / data->streamBlockSize;
+}
+
+
+/*
+	Reads the samples of the given block of a streamed dataSet into block
+*/
+static void readDataSetBlock(struct dataSet *data, int blockIndex, struct dataSetBlock *block) {
+
+	int numSamples;
+	uint64_t firstSample;
+
+	firstSample = (uint64_t)blockIndex * data->streamBlockSize;
+	numSamples = data->numSamples - (int)firstSample < data->streamBlockSize ? data->numSamples - (int)firstSample : data->streamBlockSize;
+
+	readDataSetFile(data, block->view.inputData[0], (size_t)numSamples * data->numInputs * sizeof(double), data->streamInputsOffset + (firstSample * data->numInputs * sizeof(double)));
+	readDataSetFile(data, block->view.outputData[0], (size_t)numSamples * data->numOutputs * sizeof(double), data->streamOutputsOffset + (firstSample * data->numOutputs * sizeof(double)));
+
+	block->block = blockIndex;
+	block->firstSample = (int)firstSample;
+	block->view.numSamples = numSamples;
+}
+
+
+/*
+	Advises the operating system that the given block of a streamed dataSet
+	will be read soon, so it can be read ahead in the background. Does
+	nothing where this is not supported.
+*/
+static void prefetchDataSetBlock(struct dataSet *data, int blockIndex) {
+
+#if defined(MEMORYMAPPING) && defined(POSIX_FADV_WILLNEED)
+	int numSamples;
+	uint64_t firstSample;
+
+	if (blockIndex >= getNumDataSetBlocks(data)) {
+		return;
+	}
+
+	firstSample = (uint64_t)blockIndex * data->streamBlockSize;
+	numSamples = data->numSamples - (int)firstSample < data->streamBlockSize ? data->numSamples - (int)firstSample : data->streamBlockSize;
+
+	posix_fadvise(fileno(data->stream), (off_t)(data->streamInputsOffset + (firstSample * data->numInputs * sizeof(double))), (off_t)((size_t)numSamples * data->numInputs * sizeof(double)), POSIX_FADV_WILLNEED);
+	posix_fadvise(fileno(data->stream), (off_t)(data->streamOutputsOffset + (firstSample * data->numOutputs * sizeof(double))), (off_t)((size_t)numSamples * data->numOutputs * sizeof(double)), POSIX_FADV_WILLNEED);
+#else
+	(void)data;
+	(void)blockIndex;
+#endif
+}
+
+
+/*
+	Reads size bytes from the given offset of the file of a streamed
+	dataSet. Where supported the file is read without seeking so several
+	threads can read it at once.
+*/
+static void readDataSetFile(struct dataSet *data, void *buffer, size_t size, uint64_t offset) {
+
+	size_t numRead = 0;
+
+#ifdef MEMORYMAPPING
+	ssize_t result;
+
+	while (numRead < size) {
+
+		result = pread(fileno(data->stream), (char*)buffer + numRead, size - numRead, (off_t)(offset + numRead));
+
+		if (result <= 0) {
+			break;
+		}
+
+		numRead += (size_t)result;
+	}
+#else
+	#pragma omp critical (dataSetStream)
+	{
+		if (fseek(data->stream, (long)offset, SEEK_SET) == 0) {
+			numRead = fread(buffer, 1, size, data->stream);
+		}
+	}
+#endif
+
+	if (numRead != size) {
+		printf("Error: the file of a streamed dataSet could not be read.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
+}
+
+
+/*
+	Returns the block of the given streamed dataSet holding the given
+	sample, read into the calling thread's accessed block if needed
+*/
+static struct dataSetBlock *getAccessedDataSetBlock(struct dataSet *data, int sample) {
+
+	int blockIndex;
+	struct dataSetBlock *block = NULL;
+
+	blockIndex = sample / data->streamBlockSize;
+
+	if (accessedStreamId != data->streamId) {
+
+		/* the address of the threadprivate accessedBlock identifies the calling thread */
+		#pragma omp critical (dataSetBlocks)
+		{
+			for (block = data->accessedBlocks; block != NULL && block->owner != (const void*)&accessedBlock; block = block->next);
+
+			if (block == NULL) {
+				block = (struct dataSetBlock*)malloc(sizeof(struct dataSetBlock));
+				initialiseDataSetBlock(data, block);
+				block->owner = (const void*)&accessedBlock;
+				block->next = data->accessedBlocks;
+				data->accessedBlocks = block;
+			}
+		}
+
+		accessedBlock = block;
+		accessedStreamId = data->streamId;
+	}
+
+	if (accessedBlock->block != blockIndex) {
+		readDataSetBlock(data, blockIndex, accessedBlock);
+	}
+
+	return accessedBlock;
+}
+
+
+/*
+	Initialises a dataSet from the given text file, caching it in a binary
+	sidecar file of the same name ending .bin. The sidecar records the size
+	and modification time, to the nanosecond, of the text file it was made
+	from and is used instead of the text file while they are unchanged.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromFileCached(char const *file) {
+
+	struct dataSet *data;
+	char *sidecar;
+	uint64_t sourceStamp = 0;
+
+#ifdef MEMORYMAPPING
+	struct stat textStat;
+	int64_t textModified[3];
+#endif
+
+	sidecar = (char*)malloc(strlen(file) + 5);
+	sprintf(sidecar, "%s.bin", file);
+
+#ifdef MEMORYMAPPING
+	if (stat(file, &textStat) == 0) {
+
+		textModified[0] = (int64_t)textStat.st_size;
+		textModified[1] = (int64_t)textStat.st_mtime;
+		textModified[2] = (int64_t)MODIFIEDNANOSECONDS(textStat);
+
+		/* zero marks a binary file which was not made from a text file */
+		sourceStamp = hashBytes(HASHOFFSETBASIS, textModified, sizeof(textModified));
+		sourceStamp = sourceStamp == 0 ? 1 : sourceStamp;
+
+		if (isDataSetSidecarCurrent(sidecar, sourceStamp)) {
+			data = initialiseDataSetFromBinaryFile(sidecar);
+			free(sidecar);
+			return data;
+		}
+	}
+#endif
+
+	data = initialiseDataSetFromFile(file);
+
+	writeDataSetBinary(data, sidecar, sourceStamp);
+
+	free(sidecar);
+
+	return data;
+}
+
+
+/*
+	Returns one if the given file starts with the binary dataSet header
+*/
+static int isBinaryDataSetFile(char const *file) {
+
+	FILE *fp;
+	struct binaryDataSetHeader header;
+	int isBinary;
+
+	fp = fopen(file, "rb");
+
+	if (fp == NULL) {
+		return 0;
+	}
+
+	isBinary = fread(&header, sizeof(header), 1, fp) == 1 && memcmp(header.magic, "CGPDATA", 8) == 0;
+
+	fclose(fp);
+
+	return isBinary;
+}
+
+
+/*
+	Returns one if the given sidecar is a binary dataSet file with a
+	version and byte order this CGP-Library reads which was made from the
+	text file with the given source stamp
+*/
+static int isDataSetSidecarCurrent(char const *sidecar, uint64_t sourceStamp) {
+
+	FILE *fp;
+	struct binaryDataSetHeader header;
+	int isCurrent;
+
+	fp = fopen(sidecar, "rb");
+
+	if (fp == NULL) {
+		return 0;
+	}
+
+	isCurrent = fread(&header, sizeof(header), 1, fp) == 1 && memcmp(header.magic, "CGPDATA", 8) == 0;
+	isCurrent = isCurrent && header.byteOrder == BINARYDATASETBYTEORDER && header.version <= BINARYDATASETVERSION;
+	isCurrent = isCurrent && header.sourceStamp == sourceStamp;
+
+	fclose(fp);
+
+	return isCurrent;
+}
+
+
+/*
+	frees given dataSet
+*/
+DLL_EXPORT void freeDataSet(struct dataSet *data) {
+
+	struct dataSetBlock *block;
+
+	/* attempt to prevent user double freeing */
+	if (data == NULL) {
+		printf("Warning: double freeing of dataSet prevented.\n");
+		return;
+	}
+
+#ifdef MEMORYMAPPING
+	if (data->mapping != NULL) {
+		munmap(data->mapping, data->mappingSize);
+	}
+#endif
+
+	if (data->stream != NULL) {
+
+		fclose(data->stream);
+
+		/* the blocks of every thread which accessed the samples */
+		while (data->accessedBlocks != NULL) {
+			block = data->accessedBlocks;
+			data->accessedBlocks = block->next;
+			freeDataSetBlock(block);
+			free(block);
+		}
+	}
+
+	freeAligned(data->inputValues);
+	freeAligned(data->outputValues);
+	freeAligned(data->inputColumns);
+	freeAligned(data->outputColumns);
+	free(data->inputData);
+	free(data->outputData);
+	free(data->inputBits);
+	free(data->outputBits);
+	free(data->inputFloats);
+	free(data);
+}
+
+
+/*
+	If every input and output of the given dataSet is zero or one, packs
+	them 64 samples to a word, one row of words per input and output, so
+	Boolean chromosomes can be evaluated bit-parallel. Otherwise the bits
+	are left NULL. Bits past the last sample are zero.
+*/
+static void setDataSetBits(struct dataSet *data) {
+
+	data->inputBits = NULL;
+	data->outputBits = NULL;
+
+	if (dataSetIsBoolean(data)) {
+		packDataSetBits(data);
+	}
+}
+
+
+/*
+	Returns one if every input and output of the given in-memory dataSet
+	is 0 or 1
+*/
+static int dataSetIsBoolean(struct dataSet *data) {
+
+	int i, j;
+
+	for (i = 0; i < data->numSamples; i++) {
+
+		for (j = 0; j < data->numInputs; j++) {
+			if (data->inputData[i][j] != 0 && data->inputData[i][j] != 1) {
+				return 0;
+			}
+		}
+
+		for (j = 0; j < data->numOutputs; j++) {
+			if (data->outputData[i][j] != 0 && data->outputData[i][j] != 1) {
+				return 0;
+			}
+		}
+	}
+
+	return 1;
+}
+
+
+/*
+	Sets the bit packed copy of the given in-memory dataSet, all of whose
+	values are 0 or 1
+*/
+static void packDataSetBits(struct dataSet *data) {
+
+	int i, j;
+	size_t word;
+	unsigned long long bit;
+
+	const int numWords = (data->numSamples + 63) / 64;
+
+	data->inputBits = (unsigned long long*)calloc((size_t)data->numInputs * numWords + 1, sizeof(unsigned long long));
+	data->outputBits = (unsigned long long*)calloc((size_t)data->numOutputs * numWords + 1, sizeof(unsigned long long));
+
+	for (i = 0; i < data->numSamples; i++) {
+
+		word = i / 64;
+		bit = 1ULL << (i % 64);
+
+		for (j = 0; j < data->numInputs; j++) {
+			if (data->inputData[i][j] == 1) {
+				data->inputBits[((size_t)j * numWords) + word] |= bit;
+			}
+		}
+
+		for (j = 0; j < data->numOutputs; j++) {
+			if (data->outputData[i][j] == 1) {
+				data->outputBits[((size_t)j * numWords) + word] |= bit;
+			}
+		}
+	}
+}
+
+
+/*
+	prints the given data structure to the screen
+*/
+DLL_EXPORT void printDataSet(struct dataSet *data) {
+
+	int i, j;
+
+	printf("DATA SET\n");
+	printf("Inputs: %d, ", data->numInputs);
+	printf("Outputs: %d, ", data->numOutputs);
+	printf("Samples: %d\n", data->numSamples);
+
+	for (i = 0; i < data->numSamples; i++) {
+
+		for (j = 0; j < data->numInputs; j++) {
+			printf("%f ", getDataSetSampleInput(data, i, j));
+		}
+
+		printf(" : ");
+
+		for (j = 0; j < data->numOutputs; j++) {
+			printf("%f ", getDataSetSampleOutput(data, i, j));
+		}
+
+		printf("\n");
+	}
+}
+
+
+/*
+	saves dataset to file
+*/
+DLL_EXPORT void saveDataSet(struct dataSet *data, char const *fileName) {
+
+	int i, j;
+	FILE *fp;
+
+	fp = fopen(fileName, "w");
+
+	if (fp == NULL) {
+		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
+		return;
+	}
+
+	fprintf(fp, "%d,", data->numInputs);
+	fprintf(fp, "%d,", data->numOutputs);
+	fprintf(fp, "%d,", data->numSamples);
+	fprintf(fp, "\n");
+
+
+	for (i = 0; i < data->numSamples; i++) {
+
+		for (j = 0; j < data->numInputs; j++) {
+			fprintf(fp, "%f,", getDataSetSampleInput(data, i, j));
+		}
+
+		for (j = 0; j < data->numOutputs; j++) {
+			fprintf(fp, "%f,", getDataSetSampleOutput(data, i, j));
+		}
+
+		fprintf(fp, "\n");
+	}
+
+	fclose(fp);
+}
+
+
+/*
+	saves the given dataSet in the binary dataSet file format
+*/
+DLL_EXPORT void saveDataSetBinary(struct dataSet *data, char const *fileName) {
+
+	writeDataSetBinary(data, fileName, 0);
+}
+
+
+/*
+	Saves the given dataSet as a binary file, recording the given stamp of
+	the text file it was made from, or zero
+*/
+static void writeDataSetBinary(struct dataSet *data, char const *fileName, uint64_t sourceStamp) {
+
+	int i;
+	size_t inputsSize;
+	size_t padding;
+	FILE *fp;
+	struct binaryDataSetHeader header;
+	char zeros[DATASETALIGNMENT] = {0};
+
+	fp = fopen(fileName, "wb");
+
+	if (fp == NULL) {
+		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
+		return;
+	}
+
+	inputsSize = (size_t)data->numSamples * data->numInputs * sizeof(double);
+	padding = (DATASETALIGNMENT - (inputsSize % DATASETALIGNMENT)) % DATASETALIGNMENT;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "CGPDATA", 8);
+	header.version = BINARYDATASETVERSION;
+	header.byteOrder = BINARYDATASETBYTEORDER;
+	header.numInputs = data->numInputs;
+	header.numOutputs = data->numOutputs;
+	header.numSamples = (uint64_t)data->numSamples;
+	header.inputsOffset = sizeof(header);
+	header.outputsOffset = sizeof(header) + inputsSize + padding;
+	header.sourceStamp = sourceStamp;
+
+	/* the values of streamed dataSets are not checked, so neither are those of the file */
+	if (data->stream == NULL) {
+		header.flags = BINARYDATASETCHECKED | (data->inputBits != NULL ? BINARYDATASETBOOLEAN : 0);
+	}
+
+	fwrite(&header, sizeof(header), 1, fp);
+
+	for (i = 0; i < data->numSamples; i++) {
+		fwrite(getDataSetSampleInputs(data, i), sizeof(double), data->numInputs, fp);
+	}
+
+	fwrite(zeros, 1, padding, fp);
+
+	for (i = 0; i < data->numSamples; i++) {
+		fwrite(getDataSetSampleOutputs(data, i), sizeof(double), data->numOutputs, fp);
+	}
+
+	if (fclose(fp) != 0) {
+		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
+	}
+}
+
+
+/*
+	returns the number of inputs for each sample in the given dataSet
+*/
+DLL_EXPORT int getNumDataSetInputs(struct dataSet *data) {
+	return data->numInputs;
+}
+
+
+/*
+	returns the number of outputs for each sample in the given dataSet
+*/
+DLL_EXPORT int getNumDataSetOutputs(struct dataSet *data) {
+	return data->numOutputs;
+}
+
+
+/*
+	returns the number of samples in the given dataSet
+*/
+DLL_EXPORT int getNumDataSetSamples(struct dataSet *data) {
+	return data->numSamples;
+}
+
+
+/*
+	returns the inputs of the given sample of the given dataSet
+*/
+DLL_EXPORT double *getDataSetSampleInputs(struct dataSet *data, int sample) {
+
+	struct dataSetBlock *block;
+
+	if (data->stream != NULL) {
+		block = getAccessedDataSetBlock(data, sample);
+		return block->view.inputData[sample - block->firstSample];
+	}
+
+	return data->inputData[sample];
+}
+
+
+/*
+	returns the given input of the given sample of the given dataSet
+*/
+DLL_EXPORT double getDataSetSampleInput(struct dataSet *data, int sample, int input) {
+	return getDataSetSampleInputs(data, sample)[input];
+}
+
+
+/*
+	returns the outputs of the given sample of the given dataSet
+*/
+DLL_EXPORT double *getDataSetSampleOutputs(struct dataSet *data, int sample) {
+
+	struct dataSetBlock *block;
+
+	if (data->stream != NULL) {
+		block = getAccessedDataSetBlock(data, sample);
+		return block->view.outputData[sample - block->firstSample];
+	}
+
+	return data->outputData[sample];
+}
+
+
+/*
+	returns the given output of the given sample of the given dataSet
+*/
+DLL_EXPORT double getDataSetSampleOutput(struct dataSet *data, int sample, int output) {
+	return getDataSetSampleOutputs(data, sample)[output];
+}
+
+
+/*
+	returns the values of the given input for every sample of the given
+	dataSet, or NULL if it is not in the column layout
+*/
+DLL_EXPORT const double *getDataSetInputColumn(struct dataSet *data, int input) {
+
+	if (data->inputColumns == NULL) {
+		return NULL;
+	}
+
+	return data->inputColumns + ((size_t)input * data->columnStride);
+}
+
+
+/*
+	returns the values of the given output for every sample of the given
+	dataSet, or NULL if it is not in the column layout
+*/
+DLL_EXPORT const double *getDataSetOutputColumn(struct dataSet *data, int output) {
+
+	if (data->outputColumns == NULL) {
+		return NULL;
+	}
+
+	return data->outputColumns + ((size_t)output * data->columnStride);
+}
+
+
+
+/*
+	Results Functions
+*/
+
+
+/*
+	initialises a results structure
+*/
+struct results* initialiseResults(struct parameters *params, int numRuns) {
+
+	struct results *rels;
+
+	rels = (struct results*)malloc(sizeof(struct results));
+	rels->bestChromosomes = (struct chromosome**)malloc(numRuns * sizeof(struct chromosome*));
+
+	rels->numRuns = numRuns;
+
+	/*
+		Initialised chromosomes are returns from runCGP and stored in a results structure.
+		Therefore they should not be initialised here.
+	*/
+
+	return rels;
+}
+
+
+/*
+	free a initialised results structure
+*/
+DLL_EXPORT void freeResults(struct results *rels) {
+
+	int i;
+
+	/* attempt to prevent user double freeing */
+	if (rels == NULL) {
+		printf("Warning: double freeing of results prevented.\n");
+		return;
+	}
+
+	for (i = 0; i < rels->numRuns; i++) {
+		freeChromosome(rels->bestChromosomes[i]);
+	}
+
+	free(rels->bestChromosomes);
+	free(rels);
+}
+
+
+/*
+	saves results structure to file
+*/
+DLL_EXPORT void saveResults(struct results *rels, char const *fileName) {
+
+	FILE *fp;
+	int i;
+
+	struct chromosome *chromoTemp;
+
+	if (rels == NULL) {
+		printf("Warning: cannot save uninitialised results structure. Results not saved.\n");
+		return;
+	}
+
+	fp = fopen(fileName, "w");
+
+	if (fp == NULL) {
+		printf("Warning: cannot open '%s' and so cannot save results to that file. Results not saved.\n", fileName);
+		return;
+	}
+
+	fprintf(fp, "Run,Fitness,Generations,Active Nodes\n");
+
+	for (i = 0; i < rels->numRuns; i++) {
+
+		chromoTemp = getChromosome(rels, i);
+
+		fprintf(fp, "%d,%f,%d,%d\n", i, chromoTemp->fitness, chromoTemp->generation, chromoTemp->numActiveNodes);
+
+		freeChromosome(chromoTemp);
+	}
+
+	fclose(fp);
+}
+
+
+/*
+	Gets the number of chromosomes in the results structure
+*/
+DLL_EXPORT int getNumChromosomes(struct results *rels) {
+	return rels->numRuns;
+}
+
+
+/*
+	returns the average number of chromosome active nodes from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getAverageActiveNodes(struct results *rels) {
+
+	int i;
+	double avgActiveNodes = 0;
+	struct chromosome *chromoTemp;
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+
+		chromoTemp = rels->bestChromosomes[i];
+
+		avgActiveNodes += getNumChromosomeActiveNodes(chromoTemp);
+	}
+
+	avgActiveNodes = avgActiveNodes / getNumChromosomes(rels);
+
+	return avgActiveNodes;
+}
+
+
+/*
+	returns the median number of chromosome active nodes from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getMedianActiveNodes(struct results *rels) {
+
+	int i;
+	double medActiveNodes = 0;
+
+	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+		array[i] = getNumChromosomeActiveNodes(rels->bestChromosomes[i]);
+	}
+
+	medActiveNodes = medianInt(array, getNumChromosomes(rels));
+
+	free(array);
+
+	return medActiveNodes;
+}
+
+
+static double medianInt(const int *anArray, const int length) {
+
+	int i;
+	int *copyArray = (int*)malloc(length * sizeof(int));
+	double median;
+
+	/* make a copy of the array */
+	for (i = 0; i < length; i++) {
+		copyArray[i] = anArray[i];
+	}
+
+	/* sort the copy array */
+	sortIntArray(copyArray, length);
+
+	/* if even */
+	if (length % 2 == 0) {
+		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
+	}
+
+	/* if odd */
+	else {
+		median = copyArray[ (length - 1) / 2];
+	}
+
+	free(copyArray);
+
+	return median;
+}
+
+static double medianDouble(const double *anArray, const int length) {
+
+	int i;
+	double *copyArray = (double*)malloc(length * sizeof(double));
+	double median;
+
+	/* make a copy of the array */
+	for (i = 0; i < length; i++) {
+		copyArray[i] = anArray[i];
+	}
+
+	/* sort the copy array */
+	sortDoubleArray(copyArray, length);
+
+	/* if even */
+	if (length % 2 == 0) {
+		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
+	}
+
+	/* if odd */
+	else {
+		median = copyArray[ (length - 1) / 2];
+	}
+
+	free(copyArray);
+
+	return median;
+}
+
+
+
+/*
+	returns the average chromosome fitness from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getAverageFitness(struct results *rels) {
+
+	int i;
+	double avgFit = 0;
+	struct chromosome *chromoTemp;
+
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+
+		chromoTemp = rels->bestChromosomes[i];
+
+		avgFit += getChromosomeFitness(chromoTemp);
+	}
+
+	avgFit = avgFit / getNumChromosomes(rels);
+
+	return avgFit;
+}
+
+
+/*
+	returns the median chromosome fitness from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getMedianFitness(struct results *rels) {
+
+	int i;
+	double med = 0;
+
+	double *array = (double*)malloc(getNumChromosomes(rels) * sizeof(double));
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+		array[i] = getChromosomeFitness(rels->bestChromosomes[i]);
+	}
+
+	med = medianDouble(array, getNumChromosomes(rels));
+
+	free(array);
+
+	return med;
+}
+
+
+
+/*
+	returns the average number of generations used by each run  specified in rels.
+*/
+DLL_EXPORT double getAverageGenerations(struct results *rels) {
+
+	int i;
+	double avgGens = 0;
+	struct chromosome *chromoTemp;
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+
+		chromoTemp = rels->bestChromosomes[i];
+
+		avgGens += getChromosomeGenerations(chromoTemp);
+	}
+
+	avgGens = avgGens / getNumChromosomes(rels);
+
+	return avgGens;
+}
+
+
+/*
+	returns the median number of generations used by each run  specified in rels.
+*/
+DLL_EXPORT double getMedianGenerations(struct results *rels) {
+
+	int i;
+	double med = 0;
+
+	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+		array[i] = getChromosomeGenerations(rels->bestChromosomes[i]);
+	}
+
+	med = medianInt(array, getNumChromosomes(rels));
+
+	free(array);
+
+	return med;
+}
+
+
+
+/*
+	returns a pointer to a copy of the best chromosomes found on the given run in rels.
+*/
+DLL_EXPORT struct chromosome* getChromosome(struct results *rels, int run) {
+
+	struct chromosome *chromo;
+
+	/* do some error checking */
+	if (rels == NULL) {
+		printf("Error: cannot get best chromosome from uninitialised results.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
+
+	chromo = initialiseChromosomeFromChromosome(rels->bestChromosomes[run]);
+
+	return chromo;
+}
+
+
+
+
+
+/*
+	CGP Functions
+*/
+
+
+/*
+	Other Functions
+*/
+
+
+
+
+
+
+
+
+/*
+	Mutation Methods
+*/
+
+
+
+/*
+	Conductions point mutation on the give chromosome. A predetermined
+	number of chromosome genes are randomly selected and changed to
+	a random valid allele. The number of mutations is the number of chromosome
+	genes multiplied by the mutation rate. Each gene has equal probability
+	of being selected.
+
+	DO NOT USE WITH ANN
+*/
+static void pointMutation(struct parameters *params, struct chromosome *chromo) {
+
+	int i;
+	int numGenes;
+	int numFunctionGenes, numInputGenes, numOutputGenes;
+	int numGenesToMutate;
+	int geneToMutate;
+	int nodeIndex;
+	int nodeInputIndex;
+
+	/* get the number of each type of gene */
+	numFunctionGenes = params->numNodes;
+	numInputGenes = params->numNodes * params->arity;
+	numOutputGenes = params->numOutputs;
+
+	/* set the total number of chromosome genes */
+	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+
+	/* calculate the number of genes to mutate */
+	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
+
+	/* for the number of genes to mutate */
+	for (i = 0; i < numGenesToMutate; i++) {
+
+		/* select a random gene */
+		geneToMutate = randInt(numGenes);
+
+		/* mutate function gene */
+		if (geneToMutate < numFunctionGenes) {
+
+			nodeIndex = geneToMutate;
+
+			chromo->nodeFunctions[nodeIndex] = getRandomFunction(chromo->funcSet->numFunctions);
+		}
+
+		/* mutate node input gene */
+		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+
+			chromo->nodeInputs[(nodeIndex * chromo->arity) + nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability);
+		}
+
+		/* mutate output gene */
+		else {
+			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
+			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+		}
+	}
+}
+
+
+/*
+	Same as pointMutation but also mutates weight genes. The reason this is separated is
+	that point mutation should always mutate the same number of genes. When weight genes are not
+	used many mutations will not do anything and so the number of actual mutations varies.
+	- needs explaining better...
+*/
+static void pointMutationANN(struct parameters *params, struct chromosome *chromo) {
+
+	int i;
+	int numGenes;
+	int numFunctionGenes, numInputGenes, numWeightGenes, numOutputGenes;
+	int numGenesToMutate;
+	int geneToMutate;
+	int nodeIndex;
+	int nodeInputIndex;
+
+	/* get the number of each type of gene */
+	numFunctionGenes = params->numNodes;
+	numInputGenes = params->numNodes * params->arity;
+	numWeightGenes = params->numNodes * params->arity;
+	numOutputGenes = params->numOutputs;
+
+	/* set the total number of chromosome genes */
+	numGenes = numFunctionGenes + numInputGenes + numWeightGenes + numOutputGenes;
+
+	/* calculate the number of genes to mutate */
+	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
+
+	/* for the number of genes to mutate */
+	for (i = 0; i < numGenesToMutate; i++) {
+
+		/* select a random gene */
+		geneToMutate = randInt(numGenes);
+
+		/* mutate function gene */
+		if (geneToMutate < numFunctionGenes) {
+
+			nodeIndex = geneToMutate;
+
+			chromo->nodeFunctions[nodeIndex] = getRandomFunction(chromo->funcSet->numFunctions);
+		}
+
+		/* mutate node input gene */
+		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+
+			chromo->nodeInputs[(nodeIndex * chromo->arity) + nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability);
+		}
+
+		/* mutate connection weight */
+		else if (geneToMutate < numFunctionGenes + numInputGenes + numWeightGenes) {
+
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes - numInputGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes - numInputGenes) % chromo->arity;
+
+			chromo->nodeWeights[(nodeIndex * chromo->arity) + nodeInputIndex] = getRandomConnectionWeight(params->connectionWeightRange);
+		}
+
+		/* mutate output gene */
+		else {
+			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes - numWeightGenes;
+			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+		}
+	}
+}
+
+
+
+/*
+	Conductions a single active mutation on the give chromosome.
+
+	DO NOT USE WITH ANN
+*/
+static void singleMutation(struct parameters *params, struct chromosome *chromo) {
+
+	int numFunctionGenes, numInputGenes, numOutputGenes;
+	int numGenes;
+	int geneToMutate;
+	int nodeIndex;
+	int nodeInputIndex;
+
+	int mutatedActive = 0;
+	int previousGeneValue;
+	int newGeneValue;
+
+	/* get the number of each type of gene */
+	numFunctionGenes = params->numNodes;
+	numInputGenes = params->numNodes * params->arity;
+	numOutputGenes = params->numOutputs;
+
+	/* set the total number of chromosome genes */
+	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+
+	/* while active gene not mutated */
+	while (mutatedActive == 0) {
+
+		/* select a random gene */
+		geneToMutate = randInt(numGenes);
+
+		/* mutate function gene */
+		if (geneToMutate < numFunctionGenes) {
+
+			nodeIndex = geneToMutate;
+
+			previousGeneValue = chromo->nodeFunctions[nodeIndex];
+
+			chromo->nodeFunctions[nodeIndex] = getRandomFunction(chromo->funcSet->numFunctions);
+
+			newGeneValue = chromo->nodeFunctions[nodeIndex];
+
+			if ((previousGeneValue != newGeneValue) && (chromo->nodeActive[nodeIndex] == 1)) {
+				mutatedActive = 1;
+			}
+
+		}
+
+		/* mutate node input gene */
+		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+
+			previousGeneValue = chromo->nodeInputs[(nodeIndex * chromo->arity) + nodeInputIndex];
+
+			chromo->nodeInputs[(nodeIndex * chromo->arity) + nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability);
+
+			newGeneValue = chromo->nodeInputs[(nodeIndex * chromo->arity) + nodeInputIndex];
+
+			if ((previousGeneValue != newGeneValue) && (chromo->nodeActive[nodeIndex] == 1)) {
+				mutatedActive = 1;
+			}
+		}
+
+		/* mutate output gene */
+		else {
+			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
+
+			previousGeneValue = chromo->outputNodes[nodeIndex];
+
+			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+
+			newGeneValue = chromo->outputNodes[nodeIndex];
+
+			if (previousGeneValue != newGeneValue) {
+				mutatedActive = 1;
+			}
+		}
+	}
+}
+
+
+/*
+	Conductions probabilistic mutation on the given chromosome. Each chromosome
+	gene is changed to a random valid allele with a probability specified in
+	parameters.
+*/
+static void probabilisticMutation(struct parameters *params, struct chromosome *chromo) {
+
+	int i, j;
+
+	/* for every nodes in the chromosome */
+	for (i = 0; i < params->numNodes; i++) {
+
+		/* mutate the function gene */
+		if (randDecimal() <= params->mutationRate) {
+			chromo->nodeFunctions[i] = getRandomFunction(chromo->funcSet->numFunctions);
+		}
+
+		/* for every input to each chromosome */
+		for (j = 0; j < params->arity; j++) {
+
+			/* mutate the node input */
+			if (randDecimal() <= params->mutationRate) {
+				chromo->nodeInputs[(i * chromo->arity) + j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, i, params->recurrentConnectionProbability);
+			}
+
+			/* mutate the node connection weight */
+			if (randDecimal() <= params->mutationRate) {
+				chromo->nodeWeights[(i * chromo->arity) + j] = getRandomConnectionWeight(params->connectionWeightRange);
+			}
+		}
+	}
+
+	/* for every chromosome output */
+	for (i = 0; i < params->numOutputs; i++) {
+
+		/* mutate the chromosome output */
+		if (randDecimal() <= params->mutationRate) {
+			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+		}
+	}
+}
+
+/*
+	Conductions probabilistic mutation on the active nodes in the given
+	chromosome. Each chromosome gene is changed to a random valid allele
+	with a probability specified in parameters.
+*/
+static void probabilisticMutationOnlyActive(struct parameters *params, struct chromosome *chromo) {
+
+	int i, j;
+	int activeNode;
+
+	/* for every active node in the chromosome */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		activeNode = chromo->activeNodes[i];
+
+		/* mutate the function gene */
+		if (randDecimal() <= params->mutationRate) {
+			chromo->nodeFunctions[activeNode] = getRandomFunction(chromo->funcSet->numFunctions);
+		}
+
+		/* for every input to each chromosome */
+		for (j = 0; j < params->arity; j++) {
+
+			/* mutate the node input */
+			if (randDecimal() <= params->mutationRate) {
+				chromo->nodeInputs[(activeNode * chromo->arity) + j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, activeNode, params->recurrentConnectionProbability);
+			}
+
+			/* mutate the node connection weight */
+			if (randDecimal() <= params->mutationRate) {
+				chromo->nodeWeights[(activeNode * chromo->arity) + j] = getRandomConnectionWeight(params->connectionWeightRange);
+			}
+		}
+	}
+
+	/* for every chromosome output */
+	for (i = 0; i < params->numOutputs; i++) {
+
+		/* mutate the chromosome output */
+		if (randDecimal() <= params->mutationRate) {
+			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+		}
+	}
+}
+
+
+
+/*
+	Sets the random number seed
+*/
+DLL_EXPORT void setRandomNumberSeed(unsigned int seed) {
+	seedRandomState(&randomState, seed, 0);
+}
+
+
+/*
+	repetitively applies runCGP to obtain average behaviour
+*/
+DLL_EXPORT struct results* repeatCGP(struct parameters *params, struct dataSet *data, int numGens, int numRuns) {
+
+	int i;
+	struct results *rels;
+	int updateFrequency = params->updateFrequency;
+	unsigned long long streamSeed;
+	struct randomState callerRandomState;
+
+	/* set the update frequency so as to to so generational results */
+	params->updateFrequency = 0;
+
+	rels = initialiseResults(params, numRuns);
+
+	/* the runs share one fitness cache */
+	clearFitnessCache(params);
+	resetScreeningStatistics(params);
+
+	printf("Run\tFitness\t\tGenerations\tActive Nodes\n");
+
+	/* each run has its own random number stream */
+	streamSeed = nextRandom(&randomState);
+	callerRandomState = randomState;
+
+	/*
+		Each run is a task of one team of threads, which also runs the
+		tasks for the children and large dataSets of every run, so the
+		threads are kept busy whether there are few runs, few children or
+		many samples.
+	*/
+	#pragma omp parallel default(none), private(i), shared(numRuns,rels,params,data,numGens,streamSeed), num_threads(params->numThreads)
+	{
+		#pragma omp single
+		{
+			/* for each run */
+			for (i = 0; i < numRuns; i++) {
+
+				#pragma omp task default(none), firstprivate(i), shared(rels,params,data,numGens,streamSeed)
+				{
+					seedRandomState(&randomState, streamSeed, i);
+
+					/* run cgp */
+					rels->bestChromosomes[i] = runCGPInternal(params, data, numGens);
+
+					printf("%d\t%f\t%d\t\t%d\n", i, rels->bestChromosomes[i]->fitness, rels->bestChromosomes[i]->generation, rels->bestChromosomes[i]->numActiveNodes);
+				}
+			}
+		}
+	}
+
+	randomState = callerRandomState;
+
+	printf("----------------------------------------------------\n");
+	printf("MEAN\t%f\t%f\t%f\n", getAverageFitness(rels), getAverageGenerations(rels), getAverageActiveNodes(rels));
+	printf("MEDIAN\t%f\t%f\t%f\n", getMedianFitness(rels), getMedianGenerations(rels), getMedianActiveNodes(rels));
+	printf("----------------------------------------------------\n\n");
+
+	if (params->screening == 1) {
+		printf("Children screened out: %f%%, evaluation time saved: %fs\n\n", 100 * getScreenedOutFraction(params), getScreeningTimeSaved(params));
+	}
+
+	/* restore the original value for the update frequency */
+	params->updateFrequency = updateFrequency;
+
+	return rels;
+}
+
+
+DLL_EXPORT struct chromosome* runCGP(struct parameters *params, struct dataSet *data, int numGens) {
+
+	/* cached fitness values may be for a different data set */
+	clearFitnessCache(params);
+	resetScreeningStatistics(params);
+
+	return runCGPInternal(params, data, numGens);
+}
+
+
+/*
+	runCGP without clearing the fitness cache, so that the
+	runs made by repeatCGP share the fitness cache.
+*/
+static struct chromosome *runCGPInternal(struct parameters *params, struct dataSet *data, int numGens) {
+
+	int i;
+	int gen;
+
+	/* which chromosome each child takes its fitness from, see below */
+	int *childFitnessSource;
+	int savedEvaluations = 0;
+
+	/* the parents references for incremental evaluation, NULL if not used */
+	struct incrementalReference *refs = NULL;
+
+	/* the fitness above which children cannot be selected */
+	double cutoff;
+
+	/* the random number streams of the children's evaluations */
+	unsigned long long streamSeed;
+	struct randomState callerRandomState;
+
+	/* the wall clock time per child evaluated serially and in parallel, -1 if not yet measured */
+	int evaluateInParallel;
+	int numToEvaluate;
+	double serialChildTime = -1;
+	double parallelChildTime = -1;
+	double evaluationTime;
+
+	/* bestChromo found using runCGP */
+	struct chromosome *bestChromo;
+	struct chromosome *bestChromoSoFar;
+
+	/* arrays of the parents and children */
+	struct chromosome **parentChromos;
+	struct chromosome **childrenChromos;
+
+	/* storage for chromosomes used by selection scheme */
+	struct chromosome **candidateChromos;
+	int numCandidateChromos;
+
+	/* error checking */
+	if (numGens < 0) {
+		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
+		exit(0);
+	}
+
+	if (data != NULL && params->numInputs != data->numInputs) {
+		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", data->numInputs, params->numInputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (data != NULL && params->numOutputs != data->numOutputs) {
+		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", data->numOutputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* initialise parent chromosomes */
+	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+
+	for (i = 0; i < params->mu; i++) {
+		parentChromos[i] = initialiseChromosome(params);
+	}
+
+	/* initialise children chromosomes */
+	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
+
+	for (i = 0; i < params->lambda; i++) {
+		childrenChromos[i] = initialiseChromosome(params);
+	}
+
+	/* intilise best chromosome */
+	bestChromo = initialiseChromosome(params);
+
+	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
+	if (params->evolutionaryStrategy == '+') {
+		numCandidateChromos = params->mu + params->lambda;
+	}
+	else if (params->evolutionaryStrategy == ',') {
+		numCandidateChromos = params->lambda;
+	}
+	else {
+		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
+		exit(0);
+	}
+
+	/*
+		initialise the candidateChromos. selectFittest is applied to the
+		population itself, other selection schemes are given copies.
+	*/
+	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
+
+	if (params->selectionScheme != selectFittest) {
+
+		for (i = 0; i < numCandidateChromos; i++) {
+			candidateChromos[i] = initialiseChromosome(params);
+		}
+	}
+
+	childFitnessSource = (int*)malloc(params->lambda * sizeof(int));
+
+	/* incremental evaluation is only supported for the default fitness function in double precision, and of no use when evaluating bit-parallel */
+	if (params->incrementalEvaluation == 1 && params->cutoffFitnessFunction == supervisedLearning && params->precision == 64 && data != NULL && data->stream == NULL && (data->inputBits == NULL || functionSetIsBoolean(params) == 0)) {
+
+		refs = (struct incrementalReference*)malloc(params->mu * sizeof(struct incrementalReference));
+
+		for (i = 0; i < params->mu; i++) {
+			refs[i].chromo = NULL;
+			refs[i].columns = NULL;
+			refs[i].numSamples = data->numSamples;
+		}
+	}
+
+	/* set fitness of the parents */
+	for (i = 0; i < params->mu; i++) {
+		setChromosomeFitnessCached(params, parentChromos[i], data, NULL, HUGE_VAL);
+	}
+
+	/* show the user whats going on */
+	if (params->updateFrequency != 0) {
+		printf("\n-- Starting CGP --\n\n");
+		printf("Gen\tfitness\n");
+	}
+
+	/* for each generation */
+	for (gen = 0; gen < numGens; gen++) {
+
+		/* the children are evaluated relative to their parents */
+		if (refs != NULL) {
+			setIncrementalReferences(params, parentChromos, refs, data);
+		}
+
+		/* children with a fitness above the cutoff cannot be selected */
+		cutoff = getSelectionCutoff(params, parentChromos);
+
+		/*
+			Find the children whose active genotype matches a parent or an
+			earlier child; most mutations only change inactive genes. The
+			fitness source is -1 if the child must be evaluated, -2 if it
+			has taken its fitness from a parent, -3 if it was found in the
+			fitness cache and otherwise the index of the earlier child it
+			matches.
+		*/
+		for (i = 0; i < params->lambda; i++) {
+			childFitnessSource[i] = getChildFitnessSource(params, parentChromos, childrenChromos, childFitnessSource, i);
+		}
+
+		/* each child is evaluated with its own random number stream */
+		streamSeed = nextRandom(&randomState);
+		callerRandomState = randomState;
+
+		numToEvaluate = 0;
+
+		for (i = 0; i < params->lambda; i++) {
+			if (childFitnessSource[i] == -1) {
+				numToEvaluate++;
+			}
+		}
+
+		/*
+			For cheap evaluations starting the threads can cost more than
+			they save. Both ways are timed and whichever has been faster
+			per child is used, periodically trying the other in case the
+			cost of evaluation has changed.
+		*/
+		if (numToEvaluate < 2 || canEvaluateInParallel(params->numThreads) == 0) {
+			evaluateInParallel = 0;
+		}
+		else if (parallelChildTime < 0 || serialChildTime < 0) {
+			evaluateInParallel = parallelChildTime < 0;
+		}
+		else {
+			evaluateInParallel = parallelChildTime < serialChildTime;
+
+			if (gen % PARALLELEVALUATIONRETRYPERIOD == 0) {
+				evaluateInParallel = !evaluateInParallel;
+			}
+		}
+
+		evaluationTime = getWallTime();
+
+		/* set fitness of the children of the population; streamed dataSets are read once for all the children */
+		if (data != NULL && data->stream != NULL && params->cutoffFitnessFunction == supervisedLearning) {
+			evaluateChildrenStreamed(params, childrenChromos, data, childFitnessSource, cutoff, streamSeed, evaluateInParallel);
+		}
+		else if (data != NULL && params->populationEvaluation == 1 && params->cutoffFitnessFunction == supervisedLearning) {
+			evaluateChildrenBatched(params, childrenChromos, data, childFitnessSource, cutoff, streamSeed, evaluateInParallel);
+		}
+		else {
+			evaluateChildren(params, childrenChromos, data, childFitnessSource, refs, cutoff, streamSeed, evaluateInParallel);
+		}
+
+		evaluationTime = getWallTime() - evaluationTime;
+
+		randomState = callerRandomState;
+
+		/* update the running average time per child of the way used */
+		if (numToEvaluate > 1) {
+
+			evaluationTime = evaluationTime / numToEvaluate;
+
+			if (evaluateInParallel) {
+				parallelChildTime = parallelChildTime < 0 ? evaluationTime : (0.75 * parallelChildTime) + (0.25 * evaluationTime);
+			}
+			else {
+				serialChildTime = serialChildTime < 0 ? evaluationTime : (0.75 * serialChildTime) + (0.25 * evaluationTime);
+			}
+		}
+
+		/* copy the fitness of matching children */
+		for (i = 0; i < params->lambda; i++) {
+
+			if (childFitnessSource[i] >= 0) {
+				childrenChromos[i]->fitness = childrenChromos[childFitnessSource[i]]->fitness;
+			}
+
+			if (childFitnessSource[i] != -1) {
+				savedEvaluations++;
+			}
+
+			/* later generations may only match children which were evaluated */
+			if (childFitnessSource[i] == -3) {
+				childFitnessSource[i] = -1;
+			}
+		}
+
+		/* get best chromosome */
+		bestChromoSoFar = getBestChromosome(parentChromos, childrenChromos, params->mu, params->lambda);
+
+		/* check termination conditions */
+		if (getChromosomeFitness(bestChromoSoFar) <= params->targetFitness) {
+
+			if (params->updateFrequency != 0) {
+				printf("%d\t%f - Solution Found\n", gen, bestChromoSoFar->fitness);
+			}
+
+			copyChromosome(bestChromo, bestChromoSoFar);
+
+			break;
+		}
+
+		/* display progress to the user at the update frequency specified */
+		if (params->updateFrequency != 0 && (gen % params->updateFrequency == 0 || gen >= numGens - 1) ) {
+			printf("%d\t%f\n", gen, bestChromoSoFar->fitness);
+		}
+
+		/* the population is about to change, keep the best of the final generation */
+		if (gen == numGens - 1) {
+			copyChromosome(bestChromo, bestChromoSoFar);
+		}
+
+		/* select the parents by reordering the population, no chromosomes are copied */
+		if (params->selectionScheme == selectFittest) {
+			selectFittestSlots(params, parentChromos, childrenChromos, candidateChromos, numCandidateChromos);
+		}
+
+		/*
+			Set the chromosomes which will be used by the selection scheme
+			dependant upon the evolutionary strategy. i.e. '+' all are used
+			by the selection scheme, ',' only the children are.
+		*/
+		else {
+
+			if (params->evolutionaryStrategy == '+') {
+
+				/*
+					Note: the children are placed before the parents to
+					ensure 'new blood' is always selected over old if the
+					fitness are equal.
+				*/
+
+				for (i = 0; i < numCandidateChromos; i++) {
+
+					if (i < params->lambda) {
+						copyChromosome(candidateChromos[i], childrenChromos[i] );
+					}
+					else {
+						copyChromosome(candidateChromos[i], parentChromos[i - params->lambda] );
+					}
+				}
+			}
+			else if (params->evolutionaryStrategy == ',') {
+
+				for (i = 0; i < numCandidateChromos; i++) {
+					copyChromosome(candidateChromos[i], childrenChromos[i] );
+				}
+			}
+
+			/* select the parents from the candidateChromos */
+			params->selectionScheme(params, parentChromos, candidateChromos, params->mu, numCandidateChromos);
+		}
+
+		/* create the children from the parents */
+		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda);
+	}
+
+	/* deal with formatting for displaying progress */
+	if (params->updateFrequency != 0) {
+		printf("\n");
+	}
+
+	/* copy the best best chromosome */
+	bestChromo->generation = gen;
+	bestChromo->savedEvaluations = savedEvaluations;
+
+	if (params->updateFrequency != 0 && isFitnessReused(params) == 1) {
+		printf("Fitness evaluations saved: %d\n\n", savedEvaluations);
+	}
+
+	if (params->updateFrequency != 0 && params->screening == 1) {
+		printf("Children screened out: %f%%, evaluation time saved: %fs\n\n", 100 * getScreenedOutFraction(params), getScreeningTimeSaved(params));
+	}
+
+	free(childFitnessSource);
+
+	if (refs != NULL) {
+
+		for (i = 0; i < params->mu; i++) {
+			freeIncrementalReference(&refs[i]);
+		}
+
+		free(refs);
+	}
+	/*copyChromosome(chromo, bestChromo);*/
+
+	/* free parent chromosomes */
+	for (i = 0; i < params->mu; i++) {
+		freeChromosome(parentChromos[i]);
+	}
+	free(parentChromos);
+
+	/* free children chromosomes */
+	for (i = 0; i < params->lambda; i++) {
+		freeChromosome(childrenChromos[i]);
+	}
+	free(childrenChromos);
+
+	/* free the used chromosomes and population, selectFittest only used pointers to the population */
+	if (params->selectionScheme != selectFittest) {
+
+		for (i = 0; i < numCandidateChromos; i++) {
+			freeChromosome(candidateChromos[i]);
+		}
+	}
+	free(candidateChromos);
+
+	return bestChromo;
+}
+
+
+/*
+	Returns where the given child can take its fitness from without being
+	evaluated. If its active genotype matches a parent, the parents fitness
+	is copied and -2 returned. If it matches an earlier child which is to be
+	evaluated, the index of that child is returned. Otherwise -1 is returned
+	and the child must be evaluated.
+*/
+static int getChildFitnessSource(struct parameters *params, struct chromosome **parents, struct chromosome **children, int *childFitnessSource, int child) {
+
+	int i;
+
+	if (isFitnessReused(params) == 0) {
+		return -1;
+	}
+
+	/* ensure the active genotype reflects any changes made by the reproduction scheme */
+	setChromosomeActiveNodes(children[child]);
+
+	for (i = 0; i < params->mu; i++) {
+
+		if (chromosomesPhenotypicallyEqual(children[child], parents[i])) {
+			children[child]->fitness = parents[i]->fitness;
+			return -2;
+		}
+	}
+
+	for (i = 0; i < child; i++) {
+
+		if (childFitnessSource[i] == -1 && chromosomesPhenotypicallyEqual(children[child], children[i])) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+
+/*
+	Returns the fitness cache of the given parameters, creating it if
+	it does not yet exist, or NULL if fitness caching is turned off.
+	Must be called from within the fitnessCache critical section.
+*/
+static struct fitnessCache *getFitnessCache(struct parameters *params) {
+
+	int i;
+	struct fitnessCache *cache;
+
+	if (params->fitnessCacheSize <= 0 || isFitnessReused(params) == 0) {
+		return NULL;
+	}
+
+	if (params->fitnessCache != NULL) {
+		return params->fitnessCache;
+	}
+
+	cache = (struct fitnessCache*)malloc(sizeof(struct fitnessCache));
+
+	cache->capacity = params->fitnessCacheSize;
+	cache->numEntries = 0;
+	cache->mostRecent = -1;
+	cache->leastRecent = -1;
+	cache->lookups = 0;
+	cache->hits = 0;
+	cache->genotypeBytes = 0;
+
+	/* at least twice as many buckets as entries, a power of two so the hash can be masked */
+	cache->numBuckets = 1;
+	while (cache->numBuckets < 2 * cache->capacity) {
+		cache->numBuckets *= 2;
+	}
+
+	cache->buckets = (int*)malloc(cache->numBuckets * sizeof(int));
+	cache->entries = (struct fitnessCacheEntry*)malloc(cache->capacity * sizeof(struct fitnessCacheEntry));
+
+	for (i = 0; i < cache->numBuckets; i++) {
+		cache->buckets[i] = -1;
+	}
+
+	params->fitnessCache = cache;
+
+	return cache;
+}
+
+
+/*
+	Frees the given fitness cache
+*/
+static void freeFitnessCache(struct fitnessCache *cache) {
+
+	int i;
+
+	if (cache == NULL) {
+		return;
+	}
+
+	for (i = 0; i < cache->numEntries; i++) {
+		free(cache->entries[i].genotype);
+	}
+
+	free(cache->buckets);
+	free(cache->entries);
+	free(cache);
+}
+
+
+/*
+	Removes the given fitness cache entry from the recently used list
+*/
+static void unlinkFitnessCacheEntry(struct fitnessCache *cache, int entry) {
+
+	if (cache->entries[entry].previous != -1) {
+		cache->entries[cache->entries[entry].previous].next = cache->entries[entry].next;
+	}
+	else {
+		cache->mostRecent = cache->entries[entry].next;
+	}
+
+	if (cache->entries[entry].next != -1) {
+		cache->entries[cache->entries[entry].next].previous = cache->entries[entry].previous;
+	}
+	else {
+		cache->leastRecent = cache->entries[entry].previous;
+	}
+
+	cache->entries[entry].previous = -1;
+	cache->entries[entry].next = -1;
+}
+
+
+/*
+	Places the given fitness cache entry, which must not be in the
+	recently used list, at the front of the list
+*/
+static void pushFitnessCacheEntry(struct fitnessCache *cache, int entry) {
+
+	cache->entries[entry].previous = -1;
+	cache->entries[entry].next = cache->mostRecent;
+
+	if (cache->mostRecent != -1) {
+		cache->entries[cache->mostRecent].previous = entry;
+	}
+
+	cache->mostRecent = entry;
+
+	if (cache->leastRecent == -1) {
+		cache->leastRecent = entry;
+	}
+}
+
+
+/*
+	Returns the fitness cache entry with the given key and active
+	genotype, or -1 if there is none
+*/
+static int findFitnessCacheEntry(struct fitnessCache *cache, unsigned long long key, const unsigned char *genotype, size_t genotypeSize) {
+
+	int entry = cache->buckets[key & (cache->numBuckets - 1)];
+
+	while (entry != -1) {
+
+		if (cache->entries[entry].key == key && cache->entries[entry].genotypeSize == genotypeSize && memcmp(cache->entries[entry].genotype, genotype, genotypeSize) == 0) {
+			break;
+		}
+
+		entry = cache->entries[entry].bucketNext;
+	}
+
+	return entry;
+}
+
+
+/*
+	Writes the active genotype of the given chromosome to genotype, if not
+	NULL, and returns its size in bytes: the position, function, arity
+	and connections of each active node, the connection weights of nodes
+	whose function uses them, and the output nodes. Chromosomes with equal
+	active genotypes are identical in every gene which affects their
+	behaviour or their active size.
+*/
+static size_t getActiveGenotype(struct chromosome *chromo, unsigned char *genotype) {
+
+	int i;
+	int nodeIndex;
+	int nodeArity;
+	size_t size = 0;
+
+	const int arity = chromo->arity;
+
+	size = appendGenotype(genotype, size, &chromo->numActiveNodes, sizeof(int));
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		nodeIndex = chromo->activeNodes[i];
+		nodeArity = chromo->planArity[i];
+
+		size = appendGenotype(genotype, size, &nodeIndex, sizeof(int));
+		size = appendGenotype(genotype, size, &chromo->nodeFunctions[nodeIndex], sizeof(int));
+		size = appendGenotype(genotype, size, &nodeArity, sizeof(int));
+		size = appendGenotype(genotype, size, chromo->planOperands + (i * arity), nodeArity * sizeof(int));
+
+		if (planStepUsesWeights(chromo, i)) {
+			size = appendGenotype(genotype, size, chromo->planWeights + (i * arity), nodeArity * sizeof(double));
+		}
+	}
+
+	size = appendGenotype(genotype, size, chromo->outputNodes, chromo->numOutputs * sizeof(int));
+
+	return size;
+}
+
+
+/*
+	Copies numBytes bytes from source to the given offset of genotype, if
+	not NULL, and returns the offset following them
+*/
+static size_t appendGenotype(unsigned char *genotype, size_t offset, const void *source, size_t numBytes) {
+
+	if (genotype != NULL) {
+		memcpy(genotype + offset, source, numBytes);
+	}
+
+	return offset + numBytes;
+}
+
+
+/*
+	Looks up the given chromosome in the fitness cache of the given parameters.
+	Returns one and sets the chromosome fitness if found, zero otherwise.
+*/
+static int lookupFitnessCache(struct parameters *params, struct chromosome *chromo, double cutoff) {
+
+	int entry;
+	int found = 0;
+	size_t genotypeSize;
+	unsigned char *genotype;
+	struct fitnessCache *cache;
+
+	if (chromosomeIsDeterministic(chromo) == 0 || isFitnessReused(params) == 0 || params->fitnessCacheSize <= 0) {
+		return 0;
+	}
+
+	genotypeSize = getActiveGenotype(chromo, NULL);
+	genotype = (unsigned char*)malloc(genotypeSize);
+	getActiveGenotype(chromo, genotype);
+
+	#pragma omp critical (fitnessCache)
+	{
+		cache = getFitnessCache(params);
+
+		if (cache != NULL) {
+
+			cache->lookups++;
+
+			entry = findFitnessCacheEntry(cache, chromo->activeHash, genotype, genotypeSize);
+
+			/* a rejected fitness only bounds the fitness from below */
+			if (entry != -1 && cache->entries[entry].rejected == 1 && !(cache->entries[entry].fitness > cutoff)) {
+				entry = -1;
+			}
+
+			if (entry != -1) {
+				chromo->fitness = cache->entries[entry].fitness;
+				unlinkFitnessCacheEntry(cache, entry);
+				pushFitnessCacheEntry(cache, entry);
+				cache->hits++;
+				found = 1;
+			}
+		}
+	}
+
+	free(genotype);
+
+	return found;
+}
+
+
+/*
+	Stores the fitness of the given chromosome in the fitness cache of the
+	given parameters, evicting the least recently used entry if full.
+*/
+static void insertFitnessCache(struct parameters *params, struct chromosome *chromo, double cutoff) {
+
+	int entry;
+	int rejected;
+	int *link;
+	size_t genotypeSize;
+	unsigned char *genotype;
+	struct fitnessCache *cache;
+
+	if (chromosomeIsDeterministic(chromo) == 0 || isFitnessReused(params) == 0 || params->fitnessCacheSize <= 0) {
+		return;
+	}
+
+	/* the fitness function may have stopped early */
+	rejected = chromo->fitness > cutoff;
+
+	genotypeSize = getActiveGenotype(chromo, NULL);
+	genotype = (unsigned char*)malloc(genotypeSize);
+	getActiveGenotype(chromo, genotype);
+
+	#pragma omp critical (fitnessCache)
+	{
+		cache = getFitnessCache(params);
+
+		if (cache != NULL) {
+
+			entry = findFitnessCacheEntry(cache, chromo->activeHash, genotype, genotypeSize);
+
+			/* another thread may have already stored the same chromosome */
+			if (entry != -1) {
+
+				unlinkFitnessCacheEntry(cache, entry);
+
+				if (cache->entries[entry].rejected == 1 && rejected == 0) {
+					cache->entries[entry].fitness = chromo->fitness;
+					cache->entries[entry].rejected = 0;
+				}
+			}
+
+			/* use a free entry, otherwise evict the least recently used */
+			else {
+
+				if (cache->numEntries < cache->capacity) {
+					entry = cache->numEntries;
+					cache->numEntries++;
+				}
+				else {
+
+					entry = cache->leastRecent;
+
+					/* remove the evicted entry from its bucket */
+					link = &cache->buckets[cache->entries[entry].key & (cache->numBuckets - 1)];
+
+					while (*link != entry) {
+						link = &cache->entries[*link].bucketNext;
+					}
+
+					*link = cache->entries[entry].bucketNext;
+
+					/* and from the recently used list */
+					unlinkFitnessCacheEntry(cache, entry);
+
+					cache->genotypeBytes -= (long)cache->entries[entry].genotypeSize;
+					free(cache->entries[entry].genotype);
+				}
+
+				/* the entry takes the genotype */
+				cache->entries[entry].genotype = genotype;
+				cache->entries[entry].genotypeSize = genotypeSize;
+				cache->genotypeBytes += (long)genotypeSize;
+				genotype = NULL;
+
+				cache->entries[entry].key = chromo->activeHash;
+				cache->entries[entry].fitness = chromo->fitness;
+				cache->entries[entry].rejected = rejected;
+
+				cache->entries[entry].bucketNext = cache->buckets[chromo->activeHash & (cache->numBuckets - 1)];
+				cache->buckets[chromo->activeHash & (cache->numBuckets - 1)] = entry;
+			}
+
+			pushFitnessCacheEntry(cache, entry);
+		}
+	}
+
+	free(genotype);
+}
+
+
+/*
+	Returns zero if the given chromosome uses the rand node function, so
+	its fitness may differ between evaluations, and one otherwise.
+*/
+static int chromosomeIsDeterministic(struct chromosome *chromo) {
+
+	int i;
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		if (chromo->planFunctions[i] == _randFloat) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
 
-		fprintf(fp, "\\pi");
+/*
+	Returns one if fitness values are reused. Unless set using
+	setReuseFitness they are reused only with the default fitness function,
+	which depends on nothing but the active genes, as custom fitness
+	functions may be stochastic or depend on inactive genes.
+*/
+static int isFitnessReused(struct parameters *params) {
+
+	if (params->reuseFitness != -1) {
+		return params->reuseFitness;
 	}
 
-	/* 0 */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "0", FUNCTIONNAMELENGTH) == 0 ) {
+	return params->cutoffFitnessFunction == supervisedLearning && params->sampleFitnessFunction == NULL;
+}
 
-		fprintf(fp, " 0");
+
+/*
+	Sets the fitness of the given chromosome from the fitness cache if
+	possible, otherwise evaluates it and stores the fitness in the cache.
+	If refs is not NULL the chromosome is evaluated incrementally from the
+	parent references. Chromosomes with a fitness above the cutoff may be
+	rejected early, or by screening in single precision; the fitness of
+	screened out chromosomes is not exact and so is not cached. Returns one
+	if the fitness was taken from the cache.
+*/
+static int setChromosomeFitnessCached(struct parameters *params, struct chromosome *chromo, struct dataSet *data, struct incrementalReference *refs, double cutoff) {
+
+	int sampled = 0;
+	double screenTime;
+	double exactTime = 0;
+
+	setChromosomeActiveNodes(chromo);
+
+	if (lookupFitnessCache(params, chromo, cutoff)) {
+		return 1;
 	}
 
-	/* 1 */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "1", FUNCTIONNAMELENGTH) == 0 ) {
+	if (canScreenChromosome(params, chromo, data, cutoff)) {
 
-		fprintf(fp, " 1");
+		screenTime = getWallTime();
+
+		if (screenChromosome(params, chromo, data, cutoff) == 0) {
+			addScreeningStatistics(params, 0, getWallTime() - screenTime, 0);
+		}
+
+		/* a sample of the screened out chromosomes are also evaluated in double precision */
+		else if (chromo->activeHash % SCREENINGSAMPLEPERIOD == 0) {
+			sampled = 1;
+			exactTime = getWallTime();
+			screenTime = exactTime - screenTime;
+		}
+		else {
+			addScreeningStatistics(params, 1, getWallTime() - screenTime, 0);
+			return 0;
+		}
 	}
 
-	/* other */
+	/* incremental evaluation is only possible for feed forward chromosomes */
+	if (refs != NULL && chromo->planIsFeedForward == 1) {
+		setChromosomeFitnessIncremental(params, chromo, data, refs, params->mu, cutoff);
+	}
 	else {
+		setChromosomeFitnessCutoff(params, chromo, data, cutoff);
+	}
 
-		fprintf(fp, "%s(", chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function]);
+	if (sampled) {
+		addScreeningStatistics(params, 1, screenTime, getWallTime() - exactTime);
+	}
 
-		for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+	insertFitnessCache(params, chromo, cutoff);
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+	return 0;
+}
 
-			if (i < getChromosomeNodeArity(chromo, index - chromo->numInputs) - 1)
-				fprintf(fp, ", ");
+/*
+	returns a pointer to the fittest chromosome in the two arrays of chromosomes
+
+	loops through parents and then the children in order for the children to always be selected over the parents
+*/
+static struct chromosome *getBestChromosome(struct chromosome **parents, struct chromosome **children, int numParents, int numChildren) {
+
+	int i;
+	struct chromosome *bestChromoSoFar;
+
+	bestChromoSoFar = parents[0];
+
+	for (i = 1; i < numParents; i++) {
+
+		if (parents[i]->fitness <= bestChromoSoFar->fitness) {
+			bestChromoSoFar = parents[i];
+		}
+	}
+
+	for (i = 0; i < numChildren; i++) {
+
+		if (children[i]->fitness <= bestChromoSoFar->fitness) {
+			bestChromoSoFar = children[i];
+		}
+	}
+
+	return bestChromoSoFar;
+}
+
+
+/*
+	Returns the elapsed wall clock time in seconds from an arbitrary point.
+*/
+static double getWallTime(void) {
+
+#ifdef _OPENMP
+	return omp_get_wtime();
+#else
+	return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+
+/*
+	Returns one if the children can be evaluated using the given number of
+	threads; OpenMP must be enabled.
+*/
+static int canEvaluateInParallel(int numThreads) {
+
+#ifdef _OPENMP
+	return numThreads > 1;
+#else
+	(void)numThreads;
+	return 0;
+#endif
+}
+
+
+/*
+	Returns the number of threads in the current OpenMP team, one if not
+	running in parallel.
+*/
+static int getNumTeamThreads(void) {
+
+#ifdef _OPENMP
+	return omp_get_num_threads();
+#else
+	return 1;
+#endif
+}
+
+
+/*
+	Calls function with args from the single thread of a team of
+	numThreads threads started for it, so the function can share its work
+	between the team as OpenMP tasks. The function is called directly if
+	the caller is already running in a team, numThreads is less than two
+	or OpenMP is not enabled. The function must not itself start a team,
+	as the team started may have only one thread.
+*/
+static void runInTeam(int numThreads, void (*function)(void *args), void *args) {
+
+#ifdef _OPENMP
+	if (omp_in_parallel() == 0 && numThreads > 1) {
+
+		#pragma omp parallel default(none), shared(function, args), num_threads(numThreads)
+		{
+			#pragma omp single
+			function(args);
+		}
+
+		return;
+	}
+#else
+	(void)numThreads;
+#endif
+
+	function(args);
+}
+
+
+/*
+	Sets the fitness of the children whose fitness source is -1, each with
+	its own random number stream, setting the fitness source to -3 if the
+	fitness was found in the fitness cache. In parallel each child is an
+	OpenMP task, so the children of the runs of repeatCGP and the samples
+	of large dataSets share the one team of threads. A team is started if
+	the caller is not already running in one.
+
+	A thread waiting for the tasks may run some of them itself, reseeding
+	its random number state, which the caller must therefore save.
+*/
+static void evaluateChildren(struct parameters *params, struct chromosome **children, struct dataSet *data, int *childFitnessSource, struct incrementalReference *refs, double cutoff, unsigned long long streamSeed, int inParallel) {
+
+	struct childEvaluation evaluation = {params, children, data, childFitnessSource, refs, cutoff, streamSeed, inParallel};
+
+	runInTeam(inParallel == 1 ? params->numThreads : 1, evaluateChildrenTasks, &evaluation);
+}
+
+
+/*
+	Evaluates the children as evaluateChildren, in the current team if
+	running in one
+*/
+static void evaluateChildrenTasks(void *args) {
+
+	int i;
+
+	const struct childEvaluation *evaluation = (const struct childEvaluation*)args;
+
+	struct parameters *params = evaluation->params;
+	struct chromosome **children = evaluation->children;
+	struct dataSet *data = evaluation->data;
+	int *childFitnessSource = evaluation->childFitnessSource;
+	struct incrementalReference *refs = evaluation->refs;
+	double cutoff = evaluation->cutoff;
+	unsigned long long streamSeed = evaluation->streamSeed;
+	int inParallel = evaluation->inParallel;
+
+	for (i = 0; i < params->lambda; i++) {
+
+		if (childFitnessSource[i] != -1) {
+			continue;
+		}
+
+		#pragma omp task default(none), firstprivate(i, params, children, data, childFitnessSource, refs, cutoff, streamSeed), if(inParallel)
+		{
+			seedRandomState(&randomState, streamSeed, i);
+
+			if (setChromosomeFitnessCached(params, children[i], data, refs, cutoff)) {
+				childFitnessSource[i] = -3;
+			}
+		}
+	}
+
+	#pragma omp taskwait
+}
+
+
+/*
+	Sets the fitness of the children whose fitness source is -1 using
+	supervisedLearning on a streamed dataSet, as evaluateChildren, but
+	reading each block of samples once for all of the children rather than
+	once per child. The children are evaluated on one block, each as an
+	OpenMP task if in parallel, while another task reads the next block.
+	Each child keeps its error and random number stream between blocks so
+	its fitness is the same as if evaluated alone, and a child stops being
+	evaluated once its error exceeds the cutoff.
+
+	As evaluateChildren, the caller must save its random number state.
+*/
+static void evaluateChildrenStreamed(struct parameters *params, struct chromosome **children, struct dataSet *data, int *childFitnessSource, double cutoff, unsigned long long streamSeed, int inParallel) {
+
+	struct childEvaluation evaluation = {params, children, data, childFitnessSource, NULL, cutoff, streamSeed, inParallel};
+
+	runInTeam(inParallel == 1 ? params->numThreads : 1, evaluateChildrenStreamedTasks, &evaluation);
+}
+
+
+/*
+	Evaluates the children as evaluateChildrenStreamed, in the current
+	team if running in one
+*/
+static void evaluateChildrenStreamedTasks(void *args) {
+
+	int i, j;
+	int numBlocks;
+	int numEvaluating;
+	double *errors;
+	struct randomState *childStates;
+	struct dataSetBlock blocks[2];
+	struct dataSetBlock *block;
+	struct dataSetBlock *nextBlock;
+
+	const struct childEvaluation *evaluation = (const struct childEvaluation*)args;
+
+	struct parameters *params = evaluation->params;
+	struct chromosome **children = evaluation->children;
+	struct dataSet *data = evaluation->data;
+	int *childFitnessSource = evaluation->childFitnessSource;
+	double cutoff = evaluation->cutoff;
+	unsigned long long streamSeed = evaluation->streamSeed;
+	int inParallel = evaluation->inParallel;
+
+	/* error checking */
+	if (getNumChromosomeInputs(children[0]) != getNumDataSetInputs(data)) {
+		printf("Error: the number of chromosome inputs must match the number of inputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (getNumChromosomeOutputs(children[0]) != getNumDataSetOutputs(data)) {
+		printf("Error: the number of chromosome outputs must match the number of outputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	errors = (double*)malloc(params->lambda * sizeof(double));
+	childStates = (struct randomState*)malloc(params->lambda * sizeof(struct randomState));
+
+	numBlocks = getNumDataSetBlocks(data);
+
+	initialiseDataSetBlock(data, &blocks[0]);
+	initialiseDataSetBlock(data, &blocks[1]);
+
+	/* read the first block while the children are prepared */
+	if (numBlocks > 0) {
+
+		block = &blocks[0];
+
+		#pragma omp task default(none), firstprivate(data, block), if(inParallel)
+		{
+			prefetchDataSetBlock(data, 1);
+			readDataSetBlock(data, 0, block);
+		}
+	}
+
+	for (i = 0; i < params->lambda; i++) {
+
+		if (childFitnessSource[i] != -1) {
+			continue;
+		}
+
+		#pragma omp task default(none), firstprivate(i, params, children, childFitnessSource, errors, childStates, cutoff, streamSeed), if(inParallel)
+		{
+			setChromosomeActiveNodes(children[i]);
+
+			if (lookupFitnessCache(params, children[i], cutoff)) {
+				childFitnessSource[i] = -3;
+			}
+			else {
+
+				resetChromosome(children[i]);
+
+				if (chromosomeNeedsCompiling(params, children[i])) {
+					compileChromosome(children[i]);
+				}
+
+				errors[i] = 0;
+				seedRandomState(&childStates[i], streamSeed, i);
+			}
+		}
+	}
+
+	#pragma omp taskwait
+
+	for (j = 0; j < numBlocks; j++) {
+
+		block = &blocks[j % 2];
+		nextBlock = &blocks[(j + 1) % 2];
+
+		numEvaluating = 0;
+
+		for (i = 0; i < params->lambda; i++) {
+			if (childFitnessSource[i] == -1 && (j == 0 || !(errors[i] > cutoff))) {
+				numEvaluating++;
+			}
+		}
+
+		/* every child has been rejected */
+		if (numEvaluating == 0) {
+			break;
+		}
+
+		/* read the next block while this one is used */
+		if (j + 1 < numBlocks) {
+
+			#pragma omp task default(none), firstprivate(j, data, nextBlock), if(inParallel)
+			{
+				prefetchDataSetBlock(data, j + 2);
+				readDataSetBlock(data, j + 1, nextBlock);
+			}
+		}
+
+		for (i = 0; i < params->lambda; i++) {
+
+			if (childFitnessSource[i] != -1 || (j > 0 && errors[i] > cutoff)) {
+				continue;
+			}
+
+			#pragma omp task default(none), firstprivate(i, params, children, errors, childStates, block, cutoff), if(inParallel)
+			{
+				randomState = childStates[i];
+
+				errors[i] = addSupervisedLearningErrors(params, children[i], &block->view, errors[i], cutoff);
+
+				childStates[i] = randomState;
+			}
+		}
+
+		#pragma omp taskwait
+	}
+
+	for (i = 0; i < params->lambda; i++) {
+
+		if (childFitnessSource[i] != -1) {
+			continue;
+		}
+
+		children[i]->fitness = errors[i];
+
+		insertFitnessCache(params, children[i], cutoff);
+	}
+
+	freeDataSetBlock(&blocks[0]);
+	freeDataSetBlock(&blocks[1]);
+	free(errors);
+	free(childStates);
+}
+
+
+/*
+	Sets the fitness of the children whose fitness source is -1 using
+	supervisedLearning, as evaluateChildren, but executing every child on
+	each block of samples in turn so each block is loaded into cache once
+	per generation rather than once per child. The samples are shared
+	between the threads in waves of one task of SAMPLETASKBLOCKS blocks per
+	thread, as supervisedLearningTasks, and each child's error is then
+	summed in sample order, one task per child, so the fitness and the
+	point at which a child is rejected are exactly as when evaluated alone.
+
+	Children which are recurrent, use the rand node function or can be
+	evaluated bit-parallel are evaluated alone, as evaluateChildren but
+	without screening or incremental evaluation. As evaluateChildren, the
+	caller must save its random number state.
+*/
+static void evaluateChildrenBatched(struct parameters *params, struct chromosome **children, struct dataSet *data, int *childFitnessSource, double cutoff, unsigned long long streamSeed, int inParallel) {
+
+	struct childEvaluation evaluation = {params, children, data, childFitnessSource, NULL, cutoff, streamSeed, inParallel};
+
+	runInTeam(inParallel == 1 ? params->numThreads : 1, evaluateChildrenBatchedTasks, &evaluation);
+}
+
+
+/*
+	Evaluates the children as evaluateChildrenBatched, in the current
+	team if running in one
+*/
+static void evaluateChildrenBatchedTasks(void *args) {
+
+	int i, k;
+	int waveStart;
+	int waveSize = 0;
+	int taskStart;
+	int maxWaveSize;
+	int numBatched = 0;
+	int numEvaluating;
+	int *batched;
+	int *evaluating;
+	int *useFloat;
+	int *lastSample;
+	double *errors;
+	double *outputs;
+	size_t childStride;
+
+	const struct childEvaluation *evaluation = (const struct childEvaluation*)args;
+
+	struct parameters *params = evaluation->params;
+	struct chromosome **children = evaluation->children;
+	struct dataSet *data = evaluation->data;
+	int *childFitnessSource = evaluation->childFitnessSource;
+	double cutoff = evaluation->cutoff;
+	unsigned long long streamSeed = evaluation->streamSeed;
+	int inParallel = evaluation->inParallel;
+
+	const int numSamples = getNumDataSetSamples(data);
+	const int numOutputs = getNumDataSetOutputs(data);
+	const int taskSize = SAMPLETASKBLOCKS * SAMPLEBLOCKSIZE;
+
+	/* error checking */
+	if (getNumChromosomeInputs(children[0]) != getNumDataSetInputs(data)) {
+		printf("Error: the number of chromosome inputs must match the number of inputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (getNumChromosomeOutputs(children[0]) != numOutputs) {
+		printf("Error: the number of chromosome outputs must match the number of outputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	batched = (int*)malloc(params->lambda * sizeof(int));
+	evaluating = (int*)malloc(params->lambda * sizeof(int));
+	useFloat = (int*)malloc(params->lambda * sizeof(int));
+	lastSample = (int*)malloc(params->lambda * sizeof(int));
+	errors = (double*)malloc(params->lambda * sizeof(double));
+
+	/* prepare the children to be evaluated together, evaluating the others alone */
+	for (i = 0; i < params->lambda; i++) {
+
+		if (childFitnessSource[i] != -1) {
+			continue;
+		}
+
+		#pragma omp task default(none), firstprivate(i, params, children, data, childFitnessSource, useFloat, lastSample, errors, cutoff, streamSeed), if(inParallel)
+		{
+			useFloat[i] = -1;
+
+			setChromosomeActiveNodes(children[i]);
+
+			if (lookupFitnessCache(params, children[i], cutoff)) {
+				childFitnessSource[i] = -3;
+			}
+
+			else if (children[i]->planIsFeedForward == 1 && chromosomeIsDeterministic(children[i]) == 1 && (params->sampleFitnessFunction != NULL || data->inputBits == NULL || chromosomeIsBoolean(children[i]) == 0)) {
+
+				resetChromosome(children[i]);
+
+				useFloat[i] = params->precision == 32 && chromosomeHasFloatFunctions(children[i]);
+
+				if (useFloat[i]) {
+					setDataSetFloats(data);
+				}
+
+				errors[i] = 0;
+				lastSample[i] = 0;
+			}
+
+			else {
+				seedRandomState(&randomState, streamSeed, i);
+				setChromosomeFitnessCutoff(params, children[i], data, cutoff);
+				insertFitnessCache(params, children[i], cutoff);
+			}
 		}
+	}
+
+	#pragma omp taskwait
 
-		fprintf(fp, ")");
+	for (i = 0; i < params->lambda; i++) {
+		if (childFitnessSource[i] == -1 && useFloat[i] != -1) {
+			batched[numBatched] = i;
+			numBatched++;
+		}
 	}
 
-}
+	maxWaveSize = getNumTeamThreads() * taskSize;
+	childStride = (size_t)maxWaveSize * numOutputs;
 
+	outputs = (double*)malloc((numBatched * childStride + 1) * sizeof(double));
 
-/*
-	Mutates the given chromosome using the mutation method described in parameters
-*/
-DLL_EXPORT void mutateChromosome(struct parameters *params, struct chromosome *chromo) {
+	/* for each wave of tasks */
+	for (waveStart = 0; waveStart < numSamples && numBatched > 0; waveStart += waveSize) {
 
-	params->mutationType(params, chromo);
+		waveSize = numSamples - waveStart < maxWaveSize ? numSamples - waveStart : maxWaveSize;
 
-	setChromosomeActiveNodes(chromo);
-}
+		/* the children not yet rejected */
+		numEvaluating = 0;
 
+		for (k = 0; k < numBatched; k++) {
+			if (waveStart == 0 || !(errors[batched[k]] > cutoff)) {
+				evaluating[numEvaluating] = batched[k];
+				numEvaluating++;
+			}
+		}
 
-/*
-	removes the inactive nodes from the given chromosome
-*/
-DLL_EXPORT void removeInactiveNodes(struct chromosome *chromo) {
+		if (numEvaluating == 0) {
+			break;
+		}
 
-	int i, j, k;
+		for (taskStart = 0; taskStart < waveSize; taskStart += taskSize) {
 
-	int originalNumNodes = chromo->numNodes;
+			#pragma omp task default(none), firstprivate(children, evaluating, useFloat, numEvaluating, data, outputs, childStride, waveStart, waveSize, taskStart, taskSize, numOutputs), if(inParallel)
+			executeChildrenSamples(children, evaluating, useFloat, numEvaluating, data, waveStart + taskStart, waveSize - taskStart < taskSize ? waveSize - taskStart : taskSize, outputs + ((size_t)taskStart * numOutputs), childStride);
+		}
 
-	/* set the active nodes */
-	setChromosomeActiveNodes(chromo);
+		#pragma omp taskwait
 
-	/* for all nodes */
-	for (i = 0; i < chromo->numNodes - 1; i++) {
+		/* sum the errors of each child in sample order, a block at a time */
+		for (k = 0; k < numEvaluating; k++) {
 
-		/* if the node is inactive */
-		if (chromo->nodes[i]->active == 0) {
+			#pragma omp task default(none), firstprivate(k, params, data, evaluating, lastSample, errors, outputs, childStride, waveStart, waveSize, numOutputs, cutoff), if(inParallel)
+			{
+				int j;
+				int blockSize;
+				const int child = evaluating[k];
 
-			/* set the node to be the next node */
-			for (j = i; j < chromo->numNodes - 1; j++) {
-				copyNode(chromo->nodes[j], chromo->nodes[j + 1]);
-			}
+				for (j = 0; j < waveSize; j += SAMPLEBLOCKSIZE) {
+
+					blockSize = waveSize - j < SAMPLEBLOCKSIZE ? waveSize - j : SAMPLEBLOCKSIZE;
 
-			/* */
-			for (j = 0; j < chromo->numNodes; j++) {
-				for (k = 0; k < chromo->arity; k++) {
+					errors[child] = addSampleErrors(params, errors[child], outputs + (k * childStride) + ((size_t)j * numOutputs), data->outputData + waveStart + j, blockSize, numOutputs);
 
-					if (chromo->nodes[j]->inputs[k] >= i + chromo->numInputs) {
-						chromo->nodes[j]->inputs[k]--;
+					lastSample[child] = waveStart + j + blockSize - 1;
+
+					/* the error can only increase, the chromosome is rejected */
+					if (errors[child] > cutoff) {
+						break;
 					}
 				}
 			}
+		}
 
-			/* for the number of chromosome outputs */
-			for (j = 0; j < chromo->numOutputs; j++) {
+		#pragma omp taskwait
+	}
 
-				if (chromo->outputNodes[j] >= i + chromo->numInputs) {
-					chromo->outputNodes[j]--;
-				}
-			}
+	for (k = 0; k < numBatched; k++) {
 
-			/* de-increment the number of nodes */
-			chromo->numNodes--;
+		i = batched[k];
 
-			/* made the newly assigned node be evaluated */
-			i--;
+		/* leave the chromosome in the state of the last sample used, as supervisedLearning */
+		if (numSamples > 0) {
+			executeChromosome(children[i], data->inputData[lastSample[i]]);
 		}
-	}
 
-	for (i = chromo->numNodes; i < originalNumNodes; i++) {
-		freeNode(chromo->nodes[i]);
-	}
+		children[i]->fitness = errors[i];
 
-	if (chromo->nodes[chromo->numNodes - 1]->active == 0) {
-		freeNode(chromo->nodes[chromo->numNodes - 1]);
-		chromo->numNodes--;
+		insertFitnessCache(params, children[i], cutoff);
 	}
 
-	/* reallocate the memory associated with the chromosome */
-	chromo->nodes = (struct node**)realloc(chromo->nodes, chromo->numNodes * sizeof(struct node*));
-	chromo->activeNodes = (int*)realloc(chromo->activeNodes, chromo->numNodes * sizeof(int));
-
-	/* set the active nodes */
-	setChromosomeActiveNodes(chromo);
+	free(batched);
+	free(evaluating);
+	free(useFloat);
+	free(lastSample);
+	free(errors);
+	free(outputs);
 }
 
 
 /*
-	sets the fitness of the given chromosome
+	Executes each of the given feed-forward deterministic children on
+	numSamples samples of the given in-memory dataSet starting at
+	sampleStart, in single precision for those whose useFloat is one.
+	The loop over the children is inside the loop over the blocks of
+	samples so each block stays in cache while every child uses it. The
+	outputs of the kth child are written row by row from outputs +
+	(k * childStride). The children are not changed.
 */
-DLL_EXPORT void setChromosomeFitness(struct parameters *params, struct chromosome *chromo, struct dataSet *data) {
-
-	double fitness;
+static void executeChildrenSamples(struct chromosome **children, const int *childIndices, const int *useFloat, int numChildren, struct dataSet *data, int sampleStart, int numSamples, double *outputs, size_t childStride) {
 
-	setChromosomeActiveNodes(chromo);
+	int i, k;
+	int blockSize;
+	double *columns;
+	double *inputsHold;
+	const double **operandColumns;
+	float *floatColumns;
+	float *weights;
+	const float **floatOperandColumns;
+	struct chromosome *chromo;
 
-	resetChromosome(chromo);
+	/* the children all have the same number of inputs, nodes and arity */
+	chromo = children[childIndices[0]];
 
-	fitness = params->fitnessFunction(params, chromo, data);
+	columns = (double*)malloc((chromo->numInputs + chromo->numNodes) * SAMPLEBLOCKSIZE * sizeof(double));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
+	inputsHold = (double*)malloc((chromo->arity + 1) * sizeof(double));
+	floatColumns = (float*)malloc(((size_t)chromo->numNodes + 1) * SAMPLEBLOCKSIZE * sizeof(float));
+	floatOperandColumns = malloc((chromo->arity + 1) * sizeof(*floatOperandColumns));
+	weights = (float*)malloc((chromo->arity + 1) * sizeof(float));
 
-	chromo->fitness = fitness;
-}
+	/* for each block of samples */
+	for (i = 0; i < numSamples; i += SAMPLEBLOCKSIZE) {
 
+		blockSize = numSamples - i < SAMPLEBLOCKSIZE ? numSamples - i : SAMPLEBLOCKSIZE;
 
-/*
-	reset the output values of all chromosome nodes to zero
-*/
-DLL_EXPORT void resetChromosome(struct chromosome *chromo) {
+		/* execute every child on the block */
+		for (k = 0; k < numChildren; k++) {
 
-	int i;
+			chromo = children[childIndices[k]];
 
-	for (i = 0; i < chromo->numNodes; i++) {
-		chromo->nodes[i]->output = 0;
+			if (useFloat[childIndices[k]]) {
+				executePlanBlockFloat(chromo, data, sampleStart + i, blockSize, floatColumns, floatOperandColumns, weights, outputs + (k * childStride) + ((size_t)i * chromo->numOutputs));
+			}
+			else {
+				executePlanBlock(chromo, (const double **)(data->inputData + sampleStart + i), blockSize, columns, operandColumns, inputsHold, outputs + (k * childStride) + ((size_t)i * chromo->numOutputs));
+			}
+		}
 	}
+
+	free(columns);
+	free(operandColumns);
+	free(inputsHold);
+	free(floatColumns);
+	free(floatOperandColumns);
+	free(weights);
 }
 
+
 /*
-	copies the contents of one chromosome to another. Provided the number of inputs, nodes, outputs and node arity are the same.
+	Returns the fitness above which a child cannot be selected as a parent.
+	Using selectFittest with the '+' evolutionary strategy a child must be
+	at least as fit as the least fit parent to be selected. Otherwise, or
+	if a parent's fitness is NAN, every child may be selected.
 */
-DLL_EXPORT void copyChromosome(struct chromosome *chromoDest, struct chromosome *chromoSrc) {
+static double getSelectionCutoff(struct parameters *params, struct chromosome **parents) {
 
 	int i;
+	double cutoff = -HUGE_VAL;
 
-	/* error checking  */
-	if (chromoDest->numInputs != chromoSrc->numInputs) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome inputs do not match.\n");
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
-
-	if (chromoDest->numNodes != chromoSrc->numNodes) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome nodes do not match.\n");
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
-
-	if (chromoDest->numOutputs != chromoSrc->numOutputs) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome outputs do not match.\n");
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
-
-	if (chromoDest->arity != chromoSrc->arity) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The arity of the chromosome nodes do not match.\n");
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+	if (params->evolutionaryStrategy != '+' || params->selectionScheme != selectFittest) {
+		return HUGE_VAL;
 	}
 
-	/* copy nodes and which are active */
-	for (i = 0; i < chromoSrc->numNodes; i++) {
-		copyNode(chromoDest->nodes[i],  chromoSrc->nodes[i]);
-		chromoDest->activeNodes[i] = chromoSrc->activeNodes[i];
-	}
+	for (i = 0; i < params->mu; i++) {
 
-	/* copy functionset */
-	copyFunctionSet(chromoDest->funcSet, chromoSrc->funcSet);
+		if (isnan(parents[i]->fitness) != 0) {
+			return HUGE_VAL;
+		}
 
-	/* copy each of the chromosomes outputs */
-	for (i = 0; i < chromoSrc->numOutputs; i++) {
-		chromoDest->outputNodes[i] = chromoSrc->outputNodes[i];
+		if (parents[i]->fitness > cutoff) {
+			cutoff = parents[i]->fitness;
+		}
 	}
 
-	/* copy the number of active node */
-	chromoDest->numActiveNodes = chromoSrc->numActiveNodes;
-
-	/* copy the fitness */
-	chromoDest->fitness = chromoSrc->fitness;
-
-	/* copy generation */
-	chromoDest->generation = chromoSrc->generation;
-}
-
-/*
-	Gets the number of chromosome inputs
-*/
-DLL_EXPORT int getNumChromosomeInputs(struct chromosome *chromo) {
-	return chromo->numInputs;
-}
-
-/*
-	Gets the number of chromosome nodes
-*/
-DLL_EXPORT int getNumChromosomeNodes(struct chromosome *chromo) {
-	return chromo->numNodes;
+	return cutoff;
 }
 
-/*
-	Gets the number of chromosome active nodes
-*/
-DLL_EXPORT int getNumChromosomeActiveNodes(struct chromosome *chromo) {
-	return chromo->numActiveNodes;
-}
 
 /*
-	Gets the number of chromosome outputs
+	copies the contents of funcSetSrc to funcSetDest
 */
-DLL_EXPORT int getNumChromosomeOutputs(struct chromosome *chromo) {
-	return chromo->numOutputs;
-}
+static void copyFunctionSet(struct functionSet *funcSetDest, struct functionSet *funcSetSrc) {
 
-/*
-	Gets the chromosome node arity
-*/
-DLL_EXPORT int getChromosomeNodeArity(struct chromosome *chromo, int index) {
+	int i;
 
-	int chromoArity = chromo->arity;
-	int maxArity = chromo->funcSet->maxNumInputs[chromo->nodes[index]->function];
+	funcSetDest->numFunctions = funcSetSrc->numFunctions;
 
-	if (maxArity == -1) {
-		return chromoArity;
-	}
-	else if (maxArity < chromoArity) {
-		return maxArity;
-	}
-	else {
-		return chromoArity;
+	for (i = 0; i < funcSetDest->numFunctions; i++) {
+		strncpy(funcSetDest->functionNames[i], funcSetSrc->functionNames[i], FUNCTIONNAMELENGTH);
+		funcSetDest->functions[i] = funcSetSrc->functions[i];
+		funcSetDest->blockFunctions[i] = funcSetSrc->blockFunctions[i];
+		funcSetDest->maxNumInputs[i] = funcSetSrc->maxNumInputs[i];
 	}
 }
 
-/*
-	Gets the chromosome fitness
-*/
-DLL_EXPORT double getChromosomeFitness(struct chromosome *chromo) {
-	return chromo->fitness;
-}
 
 /*
-	Gets the number of active connections in the given chromosome
+	mutate Random parent reproduction method.
 */
-DLL_EXPORT int getNumChromosomeActiveConnections(struct chromosome *chromo) {
+static void mutateRandomParent(struct parameters *params, struct chromosome **parents, struct chromosome **children, int numParents, int numChildren) {
 
 	int i;
-	int complexity = 0;
 
-	for (i = 0; i < chromo->numActiveNodes; i++) {
-		complexity += chromo->nodes[chromo->activeNodes[i]]->actArity;
-	}
+	/* for each child */
+	for (i = 0; i < numChildren; i++) {
 
-	return complexity;
-}
+		/* set child as clone of random parent */
+		copyChromosome(children[i], parents[randInt(numParents)]);
 
-/*
-	Gets the number of generations required to find the given chromosome
-*/
-DLL_EXPORT int getChromosomeGenerations(struct chromosome *chromo) {
-	return chromo->generation;
+		/* mutate newly cloned child */
+		mutateChromosome(params, children[i]);
+	}
 }
 
 
 /*
-	set the active nodes in the given chromosome
+	Selection scheme which selects the fittest members of the population
+	to be the parents.
+
+	The candidateChromos contains the current children followed by the
+ 	current parents. This means that using a stable ordering of the
+	candidateChromos results in children being selected over parents if
+	their fitnesses are equal. A desirable property in CGP to facilitate
+	neutral genetic drift.
 */
-static void setChromosomeActiveNodes(struct chromosome *chromo) {
+static void selectFittest(struct parameters *params, struct chromosome **parents, struct chromosome **candidateChromos, int numParents, int numCandidateChromos ) {
 
 	int i;
+	int *fittest;
 
-	/* error checking */
-	if (chromo == NULL) {
-		printf("Error: chromosome has not been initialised and so the active nodes cannot be set.\n");
-		return;
-	}
-
-	/* set the number of active nodes to zero */
-	chromo->numActiveNodes = 0;
-
-	/* reset the active nodes */
-	for (i = 0; i < chromo->numNodes; i++) {
-		chromo->nodes[i]->active = 0;
-	}
-
-	/* start the recursive search for active nodes from the output nodes for the number of output nodes */
-	for (i = 0; i < chromo->numOutputs; i++) {
+	fittest = (int*)malloc(numParents * sizeof(int));
 
-		/* if the output connects to a chromosome input, skip */
-		if (chromo->outputNodes[i] < chromo->numInputs) {
-			continue;
-		}
+	getFittestChromosomeIndices(candidateChromos, numCandidateChromos, fittest, numParents);
 
-		/* begin a recursive search for active nodes */
-		recursivelySetActiveNodes(chromo, chromo->outputNodes[i]);
+	for (i = 0; i < numParents; i++) {
+		copyChromosome(parents[i], candidateChromos[fittest[i]]);
 	}
 
-	/* place active nodes in order */
-	sortIntArray(chromo->activeNodes, chromo->numActiveNodes);
+	free(fittest);
 }
 
 
 /*
-	used by setActiveNodes to recursively search for active nodes
+	selectFittest applied to the population itself. The candidateChromos
+	are pointers to the current children followed, for the '+' evolutionary
+	strategy, by the current parents, ranked exactly as selectFittest
+	ranks them. The fittest become the parents and every other chromosome
+	is reused for the next children, so no chromosomes are copied.
 */
-static void recursivelySetActiveNodes(struct chromosome *chromo, int nodeIndex) {
+static void selectFittestSlots(struct parameters *params, struct chromosome **parents, struct chromosome **children, struct chromosome **candidateChromos, int numCandidateChromos) {
 
 	int i;
+	int numFreeSlots = 0;
+	int *fittest;
+	int *isSelected;
 
-	/* if the given node is an input, stop */
-	if (nodeIndex < chromo->numInputs) {
-		return;
+	for (i = 0; i < params->lambda; i++) {
+		candidateChromos[i] = children[i];
 	}
 
-	/* if the given node has already been flagged as active */
-	if (chromo->nodes[nodeIndex - chromo->numInputs]->active == 1) {
-		return;
-	}
+	if (params->evolutionaryStrategy == '+') {
 
-	/* log the node as active */
-	chromo->nodes[nodeIndex - chromo->numInputs]->active = 1;
-	chromo->activeNodes[chromo->numActiveNodes] = nodeIndex - chromo->numInputs;
-	chromo->numActiveNodes++;
+		for (i = 0; i < params->mu; i++) {
+			candidateChromos[params->lambda + i] = parents[i];
+		}
+	}
 
-	/* set the nodes actual arity*/
-	chromo->nodes[nodeIndex - chromo->numInputs]->actArity = getChromosomeNodeArity(chromo, nodeIndex - chromo->numInputs);
+	/* with the ',' evolutionary strategy every parent is replaced */
+	else {
 
-	/* recursively log all the nodes to which the current nodes connect as active */
-	for (i = 0; i < chromo->nodes[nodeIndex - chromo->numInputs]->actArity; i++) {
-		recursivelySetActiveNodes(chromo, chromo->nodes[nodeIndex - chromo->numInputs]->inputs[i]);
+		for (i = 0; i < params->mu; i++) {
+			children[numFreeSlots] = parents[i];
+			numFreeSlots++;
+		}
 	}
-}
 
+	fittest = (int*)malloc(params->mu * sizeof(int));
+	isSelected = (int*)calloc(numCandidateChromos, sizeof(int));
 
-/*
-	Sorts the given array of chromosomes by fitness, lowest to highest
-	uses insertion sort (quickish and stable)
-*/
-static void sortChromosomeArray(struct chromosome **chromoArray, int numChromos) {
+	getFittestChromosomeIndices(candidateChromos, numCandidateChromos, fittest, params->mu);
 
-	int i, j;
-	struct chromosome *chromoTmp;
+	for (i = 0; i < params->mu; i++) {
+		parents[i] = candidateChromos[fittest[i]];
+		isSelected[fittest[i]] = 1;
+	}
 
-	for (i = 0; i < numChromos; i++) {
-		for (j = i; j < numChromos; j++) {
+	for (i = 0; i < numCandidateChromos; i++) {
 
-			if (chromoArray[i]->fitness > chromoArray[j]->fitness) {
-				chromoTmp = chromoArray[i];
-				chromoArray[i] = chromoArray[j];
-				chromoArray[j] = chromoTmp;
-			}
+		if (isSelected[i] == 0) {
+			children[numFreeSlots] = candidateChromos[i];
+			numFreeSlots++;
 		}
 	}
+
+	free(fittest);
+	free(isSelected);
 }
 
 
 
 /*
-	Dataset functions
+	Initialises the genes of the node at the given position in the given chromosome
+	with random values. The chromosome's gene arrays must already be allocated.
 */
+static void initialiseNode(struct chromosome *chromo, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition) {
 
+	int i;
+	const int arity = chromo->arity;
 
-/*
-	Initialises data structure and assigns values for given arrays
-	arrays must take the form
-	inputs[numSamples][numInputs]
-	outputs[numSamples][numOutputs]
-*/
-DLL_EXPORT struct dataSet *initialiseDataSetFromArrays(int numInputs, int numOutputs, int numSamples, double *inputs, double *outputs) {
+	/* set the node's function */
+	chromo->nodeFunctions[nodePosition] = getRandomFunction(numFunctions);
+
+	/* set as active by default */
+	chromo->nodeActive[nodePosition] = 1;
+
+	/* set the nodes inputs and connection weights */
+	for (i = 0; i < arity; i++) {
+		chromo->nodeInputs[(nodePosition * arity) + i] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodePosition, recurrentConnectionProbability);
+		chromo->nodeWeights[(nodePosition * arity) + i] = getRandomConnectionWeight(connectionWeightRange);
+	}
+
+	/* set the output of the node to zero*/
+	chromo->nodeValues[chromo->numInputs + nodePosition] = 0;
+}
 
-	int i, j;
-	struct dataSet *data;
 
-	/* initialise memory for data structure */
-	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+/*
+	returns a random connection weight value
+*/
+static double getRandomConnectionWeight(double weightRange) {
+	return (randDecimal() * 2 * weightRange) - weightRange;
+}
 
-	data->numInputs = numInputs;
-	data->numOutputs = numOutputs;
-	data->numSamples = numSamples;
+/*
+	returns a random function index
+*/
+static int getRandomFunction(int numFunctions) {
 
-	data->inputData = (double**)malloc(data->numSamples * sizeof(double*));
-	data->outputData = (double**)malloc(data->numSamples * sizeof(double*));
+	/* check that funcSet contains functions */
+	if (numFunctions < 1) {
+		printf("Error: cannot assign the function gene a value as the Function Set is empty.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
 
-	for (i = 0; i < data->numSamples; i++) {
+	return randInt(numFunctions);
+}
 
-		data->inputData[i] = (double*)malloc(data->numInputs * sizeof(double));
-		data->outputData[i] = (double*)malloc(data->numOutputs * sizeof(double));
+/*
+	returns a random input for the given node
+*/
+static int getRandomNodeInput(int numChromoInputs, int numNodes, int nodePosition, double recurrentConnectionProbability) {
 
-		for (j = 0; j < data->numInputs; j++) {
-			data->inputData[i][j] = inputs[(i * data->numInputs) + j];
-		}
+	int input;
 
-		for (j = 0; j < data->numOutputs; j++) {
-			data->outputData[i][j] = outputs[(i * data->numOutputs) + j];
-		}
+	/* pick any ahdead nodes or the node itself */
+	if (randDecimal() < recurrentConnectionProbability) {
+		input = randInt(numNodes - nodePosition) + nodePosition + 1;
+	}
+	/* pick any previous node including inputs */
+	else {
+		input = randInt(numChromoInputs + nodePosition);
 	}
 
-	return data;
+	return input;
 }
 
 
 /*
-	Initialises data structure and assigns values of given file
+	returns a random chromosome output
 */
-DLL_EXPORT struct dataSet *initialiseDataSetFromFile(char const *file) {
+static int getRandomChromosomeOutput(int numInputs, int numNodes, int shortcutConnections) {
 
-	int i;
-	struct dataSet *data;
-	FILE *fp;
-	char *line, *record;
-	char buffer[1024];
-	int lineNum = -1;
-	int col;
+	int output;
 
-	/* attempt to open the given file */
-	fp = fopen(file, "r");
+	if ( shortcutConnections == 1)
+		output = randInt(numInputs + numNodes);
+	else
+		output = randInt(numNodes) + numInputs;
 
-	/* if the file cannot be found */
-	if (fp == NULL) {
-		printf("Error: file '%s' cannot be found.\nTerminating CGP-Library.\n", file);
-		exit(0);
-	}
 
-	/* initialise memory for data structure */
-	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+	return output;
+}
 
-	/* for every line in the given file */
-	while ( (line = fgets(buffer, sizeof(buffer), fp)) != NULL) {
 
-		/* deal with the first line containing meta data */
-		if (lineNum == -1) {
+/*
+	Node function add. Returns the sum of all the inputs.
+*/
+static double _add(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-			sscanf(line, "%d,%d,%d", &(data->numInputs), &(data->numOutputs), &(data->numSamples));
+	int i;
+	double sum = inputs[0];
 
-			data->inputData = (double**)malloc(data->numSamples * sizeof(double*));
-			data->outputData = (double**)malloc(data->numSamples * sizeof(double*));
+	for (i = 1; i < numInputs; i++) {
+		sum += inputs[i];
+	}
 
-			for (i = 0; i < data->numSamples; i++) {
-				data->inputData[i] = (double*)malloc(data->numInputs * sizeof(double));
-				data->outputData[i] = (double*)malloc(data->numOutputs * sizeof(double));
-			}
-		}
-		/* the other lines contain input output pairs */
-		else {
+	return sum;
+}
 
-			/* get the first value on the given line */
-			record = strtok(line, " ,\n");
-			col = 0;
+/*
+	Node function sub. Returns the first input minus all remaining inputs.
+*/
+static double _sub(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-			/* until end of line */
-			while (record != NULL) {
+	int i;
+	double sum = inputs[0];
 
-				/* if its an input value */
-				if (col < data->numInputs) {
-					data->inputData[lineNum][col] = atof(record);
-				}
+	for (i = 1; i < numInputs; i++) {
+		sum -= inputs[i];
+	}
 
-				/* if its an output value */
-				else {
+	return sum;
+}
 
-					data->outputData[lineNum][col - data->numInputs] = atof(record);
-				}
 
-				/* get the next value on the given line */
-				record = strtok(NULL, " ,\n");
+/*
+	Node function mul. Returns the multiplication of all the inputs.
+*/
+static double _mul(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-				/* increment the current col index */
-				col++;
-			}
-		}
+	int i;
+	double multiplication = inputs[0];
 
-		/* increment the current line index */
-		lineNum++;
+	for (i = 1; i < numInputs; i++) {
+		multiplication *= inputs[i];
 	}
 
-	fclose(fp);
-
-	return data;
+	return multiplication;
 }
 
 
 /*
-	frees given dataSet
+	Node function div. Returns the first input divided by the second input divided by the third input etc
 */
-DLL_EXPORT void freeDataSet(struct dataSet *data) {
+static double _divide(const int numInputs, const double *inputs, const double *connectionWeights) {
 
 	int i;
+	double divide = inputs[0];
 
-	/* attempt to prevent user double freeing */
-	if (data == NULL) {
-		printf("Warning: double freeing of dataSet prevented.\n");
-		return;
+	for (i = 1; i < numInputs; i++) {
+		divide /= inputs[i];
 	}
 
-	for (i = 0; i < data->numSamples; i++) {
-		free(data->inputData[i]);
-		free(data->outputData[i]);
-	}
+	return divide;
+}
 
-	free(data->inputData);
-	free(data->outputData);
-	free(data);
+
+/*
+	Node function abs. Returns the absolute of the first input
+*/
+static double _absolute(const int numInputs, const double *inputs, const double *connectionWeights) {
+
+	return fabs(inputs[0]);
 }
 
 
 /*
-	prints the given data structure to the screen
+	Node function sqrt.  Returns the square root of the first input
 */
-DLL_EXPORT void printDataSet(struct dataSet *data) {
+static double _squareRoot(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	int i, j;
+	return sqrt(inputs[0]);
+}
 
-	printf("DATA SET\n");
-	printf("Inputs: %d, ", data->numInputs);
-	printf("Outputs: %d, ", data->numOutputs);
-	printf("Samples: %d\n", data->numSamples);
 
-	for (i = 0; i < data->numSamples; i++) {
+/*
+	Node function squ.  Returns the square of the first input
+*/
+static double _square(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-		for (j = 0; j < data->numInputs; j++) {
-			printf("%f ", data->inputData[i][j]);
-		}
+	return pow(inputs[0], 2);
+}
 
-		printf(" : ");
 
-		for (j = 0; j < data->numOutputs; j++) {
-			printf("%f ", data->outputData[i][j]);
-		}
+/*
+	Node function cub.  Returns the cube of the first input
+*/
+static double _cube(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-		printf("\n");
-	}
+	return pow(inputs[0], 3);
 }
 
 
 /*
-	saves dataset to file
+	Node function power.  Returns the first output to the power of the second
 */
-DLL_EXPORT void saveDataSet(struct dataSet *data, char const *fileName) {
+static double _power(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	int i, j;
-	FILE *fp;
+	return pow(inputs[0], inputs[1]);
+}
 
-	fp = fopen(fileName, "w");
+/*
+	Node function exp.  Returns the exponential of the first input
+*/
+static double _exponential(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	if (fp == NULL) {
-		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
-		return;
-	}
+	return exp(inputs[0]);
+}
 
-	fprintf(fp, "%d,", data->numInputs);
-	fprintf(fp, "%d,", data->numOutputs);
-	fprintf(fp, "%d,", data->numSamples);
-	fprintf(fp, "\n");
 
+/*
+	Node function sin.  Returns the sine of the first input
+*/
+static double _sine(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	for (i = 0; i < data->numSamples; i++) {
+	return sin(inputs[0]);
+}
 
-		for (j = 0; j < data->numInputs; j++) {
-			fprintf(fp, "%f,", data->inputData[i][j]);
-		}
+/*
+	Node function cos.  Returns the cosine of the first input
+*/
+static double _cosine(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-		for (j = 0; j < data->numOutputs; j++) {
-			fprintf(fp, "%f,", data->outputData[i][j]);
-		}
+	return cos(inputs[0]);
+}
 
-		fprintf(fp, "\n");
-	}
+/*
+	Node function tan.  Returns the tangent of the first input
+*/
+static double _tangent(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	fclose(fp);
+	return tan(inputs[0]);
 }
 
 
 /*
-	returns the number of inputs for each sample in the given dataSet
+	Node function one.  Always returns 1
 */
-DLL_EXPORT int getNumDataSetInputs(struct dataSet *data) {
-	return data->numInputs;
+static double _constOne(const int numInputs, const double *inputs, const double *connectionWeights) {
+	return 1;
 }
 
+/*
+	Node function one.  Always returns 0
+*/
+static double _constZero(const int numInputs, const double *inputs, const double *connectionWeights) {
+	return 0;
+}
 
 /*
-	returns the number of outputs for each sample in the given dataSet
+	Node function one.  Always returns PI
 */
-DLL_EXPORT int getNumDataSetOutputs(struct dataSet *data) {
-	return data->numOutputs;
+static double _constPI(const int numInputs, const double *inputs, const double *connectionWeights) {
+	return M_PI;
 }
 
 
 /*
-	returns the number of samples in the given dataSet
+	Node function rand.  Returns a random number between minus one and positive one
 */
-DLL_EXPORT int getNumDataSetSamples(struct dataSet *data) {
-	return data->numSamples;
+static double _randFloat(const int numInputs, const double *inputs, const double *connectionWeights) {
+
+	double random;
+
+	random = randDecimal();
+
+	random = (random * 2) - 1;
+
+	return random;
 }
 
+/*
+	Node function and. logical AND, returns '1' if all inputs are '1'
+	else, '0'
+*/
+static double _and(const int numInputs, const double *inputs, const double *connectionWeights) {
+
+	int i;
+
+	for (i = 0; i < numInputs; i++) {
+
+		if (inputs[i] == 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
 
 /*
-	returns the inputs of the given sample of the given dataSet
+	Node function and. logical NAND, returns '0' if all inputs are '1'
+	else, '1'
 */
-DLL_EXPORT double *getDataSetSampleInputs(struct dataSet *data, int sample) {
-	return data->inputData[sample];
-}
+static double _nand(const int numInputs, const double *inputs, const double *connectionWeights) {
 
+	int i;
 
-/*
-	returns the given input of the given sample of the given dataSet
-*/
-DLL_EXPORT double getDataSetSampleInput(struct dataSet *data, int sample, int input) {
-	return data->inputData[sample][input];
-}
+	for (i = 0; i < numInputs; i++) {
 
+		if (inputs[i] == 0) {
+			return 1;
+		}
+	}
 
-/*
-	returns the outputs of the given sample of the given dataSet
-*/
-DLL_EXPORT double *getDataSetSampleOutputs(struct dataSet *data, int sample) {
-	return data->outputData[sample];
+	return 0;
 }
 
 
 /*
-	returns the given output of the given sample of the given dataSet
+	Node function or. logical OR, returns '0' if all inputs are '0'
+	else, '1'
 */
-DLL_EXPORT double getDataSetSampleOutput(struct dataSet *data, int sample, int output) {
-	return data->outputData[sample][output];
-}
+static double _or(const int numInputs, const double *inputs, const double *connectionWeights) {
 
+	int i;
 
+	for (i = 0; i < numInputs; i++) {
 
-/*
-	Results Functions
-*/
+		if (inputs[i] == 1) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
 
 
 /*
-	initialises a results structure
+	Node function nor. logical NOR, returns '1' if all inputs are '0'
+	else, '0'
 */
-struct results* initialiseResults(struct parameters *params, int numRuns) {
-
-	struct results *rels;
+static double _nor(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	rels = (struct results*)malloc(sizeof(struct results));
-	rels->bestChromosomes = (struct chromosome**)malloc(numRuns * sizeof(struct chromosome*));
+	int i;
 
-	rels->numRuns = numRuns;
+	for (i = 0; i < numInputs; i++) {
 
-	/*
-		Initialised chromosomes are returns from runCGP and stored in a results structure.
-		Therefore they should not be initialised here.
-	*/
+		if (inputs[i] == 1) {
+			return 0;
+		}
+	}
 
-	return rels;
+	return 1;
 }
 
 
 /*
-	free a initialised results structure
+	Node function xor. logical XOR, returns '1' iff one of the inputs is '1'
+	else, '0'. AKA 'one hot'.
 */
-DLL_EXPORT void freeResults(struct results *rels) {
+static double _xor(const int numInputs, const double *inputs, const double *connectionWeights) {
 
 	int i;
+	int numOnes = 0;
+	int out;
 
-	/* attempt to prevent user double freeing */
-	if (rels == NULL) {
-		printf("Warning: double freeing of results prevented.\n");
-		return;
+	for (i = 0; i < numInputs; i++) {
+
+		if (inputs[i] == 1) {
+			numOnes++;
+		}
+
+		if (numOnes > 1) {
+			break;
+		}
 	}
 
-	for (i = 0; i < rels->numRuns; i++) {
-		freeChromosome(rels->bestChromosomes[i]);
+	if (numOnes == 1) {
+		out = 1;
+	}
+	else {
+		out = 0;
 	}
 
-	free(rels->bestChromosomes);
-	free(rels);
+	return out;
 }
 
-
 /*
-	saves results structure to file
+	Node function xnor. logical XNOR, returns '0' iff one of the inputs is '1'
+	else, '1'.
 */
-DLL_EXPORT void saveResults(struct results *rels, char const *fileName) {
+static double _xnor(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	FILE *fp;
 	int i;
+	int numOnes = 0;
+	int out;
 
-	struct chromosome *chromoTemp;
-
-	if (rels == NULL) {
-		printf("Warning: cannot save uninitialised results structure. Results not saved.\n");
-		return;
-	}
+	for (i = 0; i < numInputs; i++) {
 
-	fp = fopen(fileName, "w");
+		if (inputs[i] == 1) {
+			numOnes++;
+		}
 
-	if (fp == NULL) {
-		printf("Warning: cannot open '%s' and so cannot save results to that file. Results not saved.\n", fileName);
-		return;
+		if (numOnes > 1) {
+			break;
+		}
 	}
 
-	fprintf(fp, "Run,Fitness,Generations,Active Nodes\n");
+	if (numOnes == 1) {
+		out = 0;
+	}
+	else {
+		out = 1;
+	}
 
-	for (i = 0; i < rels->numRuns; i++) {
+	return out;
+}
 
-		chromoTemp = getChromosome(rels, i);
+/*
+	Node function not. logical NOT, returns '1' if first input is '0', else '1'
+*/
+static double _not(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-		fprintf(fp, "%d,%f,%d,%d\n", i, chromoTemp->fitness, chromoTemp->generation, chromoTemp->numActiveNodes);
+	double out;
 
-		freeChromosome(chromoTemp);
+	if (inputs[0] == 0) {
+		out = 1;
+	}
+	else {
+		out = 0;
 	}
 
-	fclose(fp);
+	return out;
 }
 
 
 /*
-	Gets the number of chromosomes in the results structure
+	Node function wire. simply acts as a wire returning the first input
 */
-DLL_EXPORT int getNumChromosomes(struct results *rels) {
-	return rels->numRuns;
+static double _wire(const int numInputs, const double *inputs, const double *connectionWeights) {
+
+	double out;
+
+	out = inputs[0];
+
+	return out;
 }
 
 
 /*
-	returns the average number of chromosome active nodes from repeated
-	run results specified in rels.
+	Node function sigmoid. returns the sigmoid of the sum of weighted inputs.
+	The specific sigmoid function used in the logistic function.
+	range: [0,1]
 */
-DLL_EXPORT double getAverageActiveNodes(struct results *rels) {
-
-	int i;
-	double avgActiveNodes = 0;
-	struct chromosome *chromoTemp;
-
-	for (i = 0; i < getNumChromosomes(rels); i++) {
+static double _sigmoid(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-		chromoTemp = rels->bestChromosomes[i];
+	double weightedInputSum;
+	double out;
 
-		avgActiveNodes += getNumChromosomeActiveNodes(chromoTemp);
-	}
+	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
 
-	avgActiveNodes = avgActiveNodes / getNumChromosomes(rels);
+	out = 1 / (1 + exp(-weightedInputSum));
 
-	return avgActiveNodes;
+	return out;
 }
 
-
 /*
-	returns the median number of chromosome active nodes from repeated
-	run results specified in rels.
+	Node function Gaussian. returns the Gaussian of the sum of weighted inputs.
+	range: [0,1]
 */
-DLL_EXPORT double getMedianActiveNodes(struct results *rels) {
-
-	int i;
-	double medActiveNodes = 0;
+static double _gaussian(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+	double weightedInputSum;
+	double out;
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
-		array[i] = getNumChromosomeActiveNodes(rels->bestChromosomes[i]);
-	}
+	int centre = 0;
+	int width = 1;
 
-	medActiveNodes = medianInt(array, getNumChromosomes(rels));
+	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
 
-	free(array);
+	out = exp(-(pow(weightedInputSum - centre, 2)) / (2 * pow(width, 2)));
 
-	return medActiveNodes;
+	return out;
 }
 
 
-static double medianInt(const int *anArray, const int length) {
-
-	int i;
-	int *copyArray = (int*)malloc(length * sizeof(int));
-	double median;
+/*
+	Node function step. returns the step function of the sum of weighted inputs.
+	range: [0,1]
+*/
+static double _step(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	/* make a copy of the array */
-	for (i = 0; i < length; i++) {
-		copyArray[i] = anArray[i];
-	}
+	double weightedInputSum;
+	double out;
 
-	/* sort the copy array */
-	sortIntArray(copyArray, length);
+	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
 
-	/* if even */
-	if (length % 2 == 0) {
-		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
+	if (weightedInputSum < 0) {
+		out = 0;
 	}
-
-	/* if odd */
 	else {
-		median = copyArray[ (length - 1) / 2];
+		out = 1;
 	}
 
-	free(copyArray);
-
-	return median;
+	return out;
 }
 
-static double medianDouble(const double *anArray, const int length) {
 
-	int i;
-	double *copyArray = (double*)malloc(length * sizeof(double));
-	double median;
+/*
+	Node function step. returns the step function of the sum of weighted inputs.
+	range: [-1,1]
+*/
+static double _softsign(const int numInputs, const double *inputs, const double *connectionWeights) {
+
+	double weightedInputSum;
+	double out;
+
+	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
+
+	out = weightedInputSum / (1 + fabs(weightedInputSum));
+
+	return out;
+}
 
-	/* make a copy of the array */
-	for (i = 0; i < length; i++) {
-		copyArray[i] = anArray[i];
-	}
 
-	/* sort the copy array */
-	sortDoubleArray(copyArray, length);
+/*
+	Node function tanh. returns the tanh function of the sum of weighted inputs.
+	range: [-1,1]
+*/
+static double _hyperbolicTangent(const int numInputs, const double *inputs, const double *connectionWeights) {
 
-	/* if even */
-	if (length % 2 == 0) {
-		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
-	}
+	double weightedInputSum;
+	double out;
 
-	/* if odd */
-	else {
-		median = copyArray[ (length - 1) / 2];
-	}
+	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
 
-	free(copyArray);
+	out = tanh(weightedInputSum);
 
-	return median;
+	return out;
 }
 
 
-
 /*
-	returns the average chromosome fitness from repeated
-	run results specified in rels.
+	Returns the sum of the weighted inputs.
 */
-DLL_EXPORT double getAverageFitness(struct results *rels) {
+static double sumWeigtedInputs(const int numInputs, const double *inputs, const double *connectionWeights) {
 
 	int i;
-	double avgFit = 0;
-	struct chromosome *chromoTemp;
-
-
-	for (i = 0; i < getNumChromosomes(rels); i++) {
-
-		chromoTemp = rels->bestChromosomes[i];
+	double weightedSum = 0;
 
-		avgFit += getChromosomeFitness(chromoTemp);
+	for (i = 0; i < numInputs; i++) {
+		weightedSum += (inputs[i] * connectionWeights[i]);
 	}
 
-	avgFit = avgFit / getNumChromosomes(rels);
-
-	return avgFit;
+	return weightedSum;
 }
 
 
 /*
-	returns the median chromosome fitness from repeated
-	run results specified in rels.
+	Sample block variants of the preset node functions. Each takes one
+	column of numSamples values per node input and writes numSamples
+	outputs. For every sample the same operations are applied in the
+	same order as the scalar node function, so the results are identical.
 */
-DLL_EXPORT double getMedianFitness(struct results *rels) {
 
-	int i;
-	double med = 0;
+/*
+	Block node function add.
+*/
+BLOCKFUNCTIONTARGETS static void _addBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	double *array = (double*)malloc(getNumChromosomes(rels) * sizeof(double));
+	int i, k;
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
-		array[i] = getChromosomeFitness(rels->bestChromosomes[i]);
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = inputs[0][k];
 	}
 
-	med = medianDouble(array, getNumChromosomes(rels));
+	for (i = 1; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] += inputs[i][k];
+		}
+	}
+}
 
-	free(array);
+/*
+	Block node function sub.
+*/
+BLOCKFUNCTIONTARGETS static void _subBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	return med;
-}
+	int i, k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = inputs[0][k];
+	}
 
+	for (i = 1; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] -= inputs[i][k];
+		}
+	}
+}
 
 /*
-	returns the average number of generations used by each run  specified in rels.
+	Block node function mul.
 */
-DLL_EXPORT double getAverageGenerations(struct results *rels) {
-
-	int i;
-	double avgGens = 0;
-	struct chromosome *chromoTemp;
-
-	for (i = 0; i < getNumChromosomes(rels); i++) {
+BLOCKFUNCTIONTARGETS static void _mulBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-		chromoTemp = rels->bestChromosomes[i];
+	int i, k;
 
-		avgGens += getChromosomeGenerations(chromoTemp);
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = inputs[0][k];
 	}
 
-	avgGens = avgGens / getNumChromosomes(rels);
-
-	return avgGens;
+	for (i = 1; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] *= inputs[i][k];
+		}
+	}
 }
 
-
 /*
-	returns the median number of generations used by each run  specified in rels.
+	Block node function div.
 */
-DLL_EXPORT double getMedianGenerations(struct results *rels) {
+BLOCKFUNCTIONTARGETS static void _divideBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	int i;
-	double med = 0;
+	int i, k;
 
-	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = inputs[0][k];
+	}
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
-		array[i] = getChromosomeGenerations(rels->bestChromosomes[i]);
+	for (i = 1; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] /= inputs[i][k];
+		}
 	}
+}
 
-	med = medianInt(array, getNumChromosomes(rels));
+/*
+	Block node function abs.
+*/
+BLOCKFUNCTIONTARGETS static void _absoluteBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	free(array);
+	int k;
 
-	return med;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = fabs(inputs[0][k]);
+	}
 }
 
+/*
+	Block node function sqrt.
+*/
+BLOCKFUNCTIONTARGETS static void _squareRootBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
+
+	int k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = sqrt(inputs[0][k]);
+	}
+}
 
 /*
-	returns a pointer to a copy of the best chromosomes found on the given run in rels.
+	Block node function sq.
 */
-DLL_EXPORT struct chromosome* getChromosome(struct results *rels, int run) {
+static void _squareBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	struct chromosome *chromo;
+	int k;
 
-	/* do some error checking */
-	if (rels == NULL) {
-		printf("Error: cannot get best chromosome from uninitialised results.\nTerminating CGP-Library.\n");
-		exit(0);
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = pow(inputs[0][k], 2);
 	}
+}
 
-	chromo = initialiseChromosomeFromChromosome(rels->bestChromosomes[run]);
+/*
+	Block node function cube.
+*/
+static void _cubeBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	return chromo;
-}
+	int k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = pow(inputs[0][k], 3);
+	}
+}
 
+/*
+	Block node function pow.
+*/
+static void _powerBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
+	int k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = pow(inputs[0][k], inputs[1][k]);
+	}
+}
 
 /*
-	CGP Functions
+	Block node function exp.
 */
+static void _exponentialBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
+	int k;
+
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = exp(inputs[0][k]);
+	}
+}
 
 /*
-	Other Functions
+	Block node function sin.
 */
+static void _sineBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
+	int k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = sin(inputs[0][k]);
+	}
+}
+
+/*
+	Block node function cos.
+*/
+static void _cosineBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
+	int k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = cos(inputs[0][k]);
+	}
+}
 
+/*
+	Block node function tan.
+*/
+static void _tangentBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
+	int k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = tan(inputs[0][k]);
+	}
+}
 
 /*
-	Mutation Methods
+	Block node function one.
 */
+BLOCKFUNCTIONTARGETS static void _constOneBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
+	int k;
 
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 1;
+	}
+}
 
 /*
-	Conductions point mutation on the give chromosome. A predetermined
-	number of chromosome genes are randomly selected and changed to
-	a random valid allele. The number of mutations is the number of chromosome
-	genes multiplied by the mutation rate. Each gene has equal probability
-	of being selected.
-
-	DO NOT USE WITH ANN
+	Block node function zero.
 */
-static void pointMutation(struct parameters *params, struct chromosome *chromo) {
+BLOCKFUNCTIONTARGETS static void _constZeroBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	int i;
-	int numGenes;
-	int numFunctionGenes, numInputGenes, numOutputGenes;
-	int numGenesToMutate;
-	int geneToMutate;
-	int nodeIndex;
-	int nodeInputIndex;
+	int k;
 
-	/* get the number of each type of gene */
-	numFunctionGenes = params->numNodes;
-	numInputGenes = params->numNodes * params->arity;
-	numOutputGenes = params->numOutputs;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 0;
+	}
+}
 
-	/* set the total number of chromosome genes */
-	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+/*
+	Block node function pi.
+*/
+BLOCKFUNCTIONTARGETS static void _constPIBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	/* calculate the number of genes to mutate */
-	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
+	int k;
 
-	/* for the number of genes to mutate */
-	for (i = 0; i < numGenesToMutate; i++) {
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = M_PI;
+	}
+}
 
-		/* select a random gene */
-		geneToMutate = randInt(numGenes);
+/*
+	Block node function and.
+*/
+BLOCKFUNCTIONTARGETS static void _andBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-		/* mutate function gene */
-		if (geneToMutate < numFunctionGenes) {
+	int i, k;
 
-			nodeIndex = geneToMutate;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 1;
+	}
 
-			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions);
+	for (i = 0; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] = inputs[i][k] == 0 ? 0 : outputs[k];
 		}
+	}
+}
 
-		/* mutate node input gene */
-		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+/*
+	Block node function nand.
+*/
+BLOCKFUNCTIONTARGETS static void _nandBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+	int i, k;
 
-			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability);
-		}
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 0;
+	}
 
-		/* mutate output gene */
-		else {
-			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
-			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+	for (i = 0; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] = inputs[i][k] == 0 ? 1 : outputs[k];
 		}
 	}
 }
 
+/*
+	Block node function or.
+*/
+BLOCKFUNCTIONTARGETS static void _orBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
+
+	int i, k;
+
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 0;
+	}
+
+	for (i = 0; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] = inputs[i][k] == 1 ? 1 : outputs[k];
+		}
+	}
+}
 
 /*
-	Same as pointMutation but also mutates weight genes. The reason this is separated is
-	that point mutation should always mutate the same number of genes. When weight genes are not
-	used many mutations will not do anything and so the number of actual mutations varies.
-	- needs explaining better...
+	Block node function nor.
 */
-static void pointMutationANN(struct parameters *params, struct chromosome *chromo) {
+BLOCKFUNCTIONTARGETS static void _norBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	int i;
-	int numGenes;
-	int numFunctionGenes, numInputGenes, numWeightGenes, numOutputGenes;
-	int numGenesToMutate;
-	int geneToMutate;
-	int nodeIndex;
-	int nodeInputIndex;
+	int i, k;
 
-	/* get the number of each type of gene */
-	numFunctionGenes = params->numNodes;
-	numInputGenes = params->numNodes * params->arity;
-	numWeightGenes = params->numNodes * params->arity;
-	numOutputGenes = params->numOutputs;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 1;
+	}
 
-	/* set the total number of chromosome genes */
-	numGenes = numFunctionGenes + numInputGenes + numWeightGenes + numOutputGenes;
+	for (i = 0; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] = inputs[i][k] == 1 ? 0 : outputs[k];
+		}
+	}
+}
 
-	/* calculate the number of genes to mutate */
-	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
+/*
+	Block node function xor. The outputs are used to count the
+	number of inputs which are '1'.
+*/
+BLOCKFUNCTIONTARGETS static void _xorBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	/* for the number of genes to mutate */
-	for (i = 0; i < numGenesToMutate; i++) {
+	int i, k;
 
-		/* select a random gene */
-		geneToMutate = randInt(numGenes);
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 0;
+	}
 
-		/* mutate function gene */
-		if (geneToMutate < numFunctionGenes) {
+	for (i = 0; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] += inputs[i][k] == 1;
+		}
+	}
 
-			nodeIndex = geneToMutate;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = outputs[k] == 1 ? 1 : 0;
+	}
+}
 
-			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions);
-		}
+/*
+	Block node function xnor. The outputs are used to count the
+	number of inputs which are '1'.
+*/
+BLOCKFUNCTIONTARGETS static void _xnorBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-		/* mutate node input gene */
-		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+	int i, k;
 
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 0;
+	}
 
-			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability);
+	for (i = 0; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] += inputs[i][k] == 1;
 		}
+	}
 
-		/* mutate connection weight */
-		else if (geneToMutate < numFunctionGenes + numInputGenes + numWeightGenes) {
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = outputs[k] == 1 ? 0 : 1;
+	}
+}
 
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes - numInputGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes - numInputGenes) % chromo->arity;
+/*
+	Block node function not.
+*/
+BLOCKFUNCTIONTARGETS static void _notBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-			chromo->nodes[nodeIndex]->weights[nodeInputIndex] = getRandomConnectionWeight(params->connectionWeightRange);
-		}
+	int k;
 
-		/* mutate output gene */
-		else {
-			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes - numWeightGenes;
-			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
-		}
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = inputs[0][k] == 0 ? 1 : 0;
 	}
 }
 
+/*
+	Block node function wire.
+*/
+static void _wireBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
+	memcpy(outputs, inputs[0], numSamples * sizeof(double));
+}
 
 /*
-	Conductions a single active mutation on the give chromosome.
-
-	DO NOT USE WITH ANN
+	Block node function sigmoid.
 */
-static void singleMutation(struct parameters *params, struct chromosome *chromo) {
+static void _sigmoidBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	int numFunctionGenes, numInputGenes, numOutputGenes;
-	int numGenes;
-	int geneToMutate;
-	int nodeIndex;
-	int nodeInputIndex;
+	int k;
 
-	int mutatedActive = 0;
-	int previousGeneValue;
-	int newGeneValue;
+	sumWeigtedInputsBlock(numInputs, inputs, connectionWeights, outputs, numSamples);
 
-	/* get the number of each type of gene */
-	numFunctionGenes = params->numNodes;
-	numInputGenes = params->numNodes * params->arity;
-	numOutputGenes = params->numOutputs;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 1 / (1 + exp(-outputs[k]));
+	}
+}
 
-	/* set the total number of chromosome genes */
-	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+/*
+	Block node function Gaussian.
+*/
+static void _gaussianBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-	/* while active gene not mutated */
-	while (mutatedActive == 0) {
+	int k;
 
-		/* select a random gene */
-		geneToMutate = randInt(numGenes);
+	int centre = 0;
+	int width = 1;
 
-		/* mutate function gene */
-		if (geneToMutate < numFunctionGenes) {
+	sumWeigtedInputsBlock(numInputs, inputs, connectionWeights, outputs, numSamples);
 
-			nodeIndex = geneToMutate;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = exp(-(pow(outputs[k] - centre, 2)) / (2 * pow(width, 2)));
+	}
+}
 
-			previousGeneValue = chromo->nodes[nodeIndex]->function;
+/*
+	Block node function step.
+*/
+BLOCKFUNCTIONTARGETS static void _stepBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions);
+	int k;
 
-			newGeneValue = chromo->nodes[nodeIndex]->function;
+	sumWeigtedInputsBlock(numInputs, inputs, connectionWeights, outputs, numSamples);
 
-			if ((previousGeneValue != newGeneValue) && (chromo->nodes[nodeIndex]->active == 1)) {
-				mutatedActive = 1;
-			}
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = outputs[k] < 0 ? 0 : 1;
+	}
+}
 
-		}
+/*
+	Block node function softsign.
+*/
+BLOCKFUNCTIONTARGETS static void _softsignBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-		/* mutate node input gene */
-		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+	int k;
 
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+	sumWeigtedInputsBlock(numInputs, inputs, connectionWeights, outputs, numSamples);
 
-			previousGeneValue = chromo->nodes[nodeIndex]->inputs[nodeInputIndex];
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = outputs[k] / (1 + fabs(outputs[k]));
+	}
+}
 
-			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability);
+/*
+	Block node function tanh.
+*/
+static void _hyperbolicTangentBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-			newGeneValue = chromo->nodes[nodeIndex]->inputs[nodeInputIndex];
+	int k;
 
-			if ((previousGeneValue != newGeneValue) && (chromo->nodes[nodeIndex]->active == 1)) {
-				mutatedActive = 1;
-			}
-		}
+	sumWeigtedInputsBlock(numInputs, inputs, connectionWeights, outputs, numSamples);
 
-		/* mutate output gene */
-		else {
-			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = tanh(outputs[k]);
+	}
+}
 
-			previousGeneValue = chromo->outputNodes[nodeIndex];
+/*
+	Writes the sum of the weighted inputs of each sample to outputs.
+*/
+WEIGHTEDSUMTARGETS static void sumWeigtedInputsBlock(const int numInputs, const double **inputs, const double *connectionWeights, double *outputs, const int numSamples) {
 
-			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+	int i, k;
 
-			newGeneValue = chromo->outputNodes[nodeIndex];
+	for (k = 0; k < numSamples; k++) {
+		outputs[k] = 0;
+	}
 
-			if (previousGeneValue != newGeneValue) {
-				mutatedActive = 1;
-			}
+	for (i = 0; i < numInputs; i++) {
+		for (k = 0; k < numSamples; k++) {
+			outputs[k] += (inputs[i][k] * connectionWeights[i]);
 		}
 	}
 }
 
 
+
+
+
 /*
-	Conductions probabilistic mutation on the given chromosome. Each chromosome
-	gene is changed to a random valid allele with a probability specified in
-	parameters.
+	The default fitness function used by CGP-Library.
+	Simply assigns an error of the sum of the absolute differences between the target and actual outputs for all outputs over all samples,
+	or the sum of the sample fitness function if one is set.
+	Stops early, returning the error so far, once the error exceeds the cutoff.
 */
-static void probabilisticMutation(struct parameters *params, struct chromosome *chromo) {
+static double supervisedLearning(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
 
-	int i, j;
+	int useFloat;
 
-	/* for every nodes in the chromosome */
-	for (i = 0; i < params->numNodes; i++) {
+	/* error checking */
+	if (getNumChromosomeInputs(chromo) != getNumDataSetInputs(data)) {
+		printf("Error: the number of chromosome inputs must match the number of inputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-		/* mutate the function gene */
-		if (randDecimal() <= params->mutationRate) {
-			chromo->nodes[i]->function = getRandomFunction(chromo->funcSet->numFunctions);
-		}
+	if (getNumChromosomeOutputs(chromo) != getNumDataSetOutputs(data)) {
+		printf("Error: the number of chromosome outputs must match the number of outputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-		/* for every input to each chromosome */
-		for (j = 0; j < params->arity; j++) {
+	/* streamed dataSets are read a block at a time */
+	if (data->stream != NULL) {
+		return supervisedLearningStreamed(params, chromo, data, cutoff);
+	}
 
-			/* mutate the node input */
-			if (randDecimal() <= params->mutationRate) {
-				chromo->nodes[i]->inputs[j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, i, params->recurrentConnectionProbability);
-			}
+	/* Boolean chromosomes on Boolean dataSets are evaluated 64 samples at a time */
+	if (params->sampleFitnessFunction == NULL && data->inputBits != NULL && chromosomeIsBoolean(chromo)) {
+		return supervisedLearningBoolean(chromo, data, cutoff);
+	}
 
-			/* mutate the node connection weight */
-			if (randDecimal() <= params->mutationRate) {
-				chromo->nodes[i]->weights[j] = getRandomConnectionWeight(params->connectionWeightRange);
-			}
-		}
+	/* single precision is used if every node function has a single precision version */
+	useFloat = params->precision == 32 && chromosomeHasFloatFunctions(chromo);
+
+	if (useFloat) {
+		setDataSetFloats(data);
 	}
 
-	/* for every chromosome output */
-	for (i = 0; i < params->numOutputs; i++) {
+	/* large dataSets are shared between threads */
+	if (canSplitSampleBlocks(params, chromo, getNumDataSetSamples(data))) {
+		return supervisedLearningTasks(params, chromo, data, cutoff, useFloat);
+	}
 
-		/* mutate the chromosome output */
-		if (randDecimal() <= params->mutationRate) {
-			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
-		}
+	if (useFloat) {
+		return supervisedLearningFloat(params, chromo, data, cutoff);
 	}
+
+	return addSupervisedLearningErrors(params, chromo, data, 0, cutoff);
 }
 
+
 /*
-	Conductions probabilistic mutation on the active nodes in the given
-	chromosome. Each chromosome gene is changed to a random valid allele
-	with a probability specified in parameters.
+	Adds the errors of the samples of the given in-memory dataSet, as
+	supervisedLearning in double precision, to the given error and returns
+	the sum. Stops early once the error exceeds the cutoff, leaving the
+	chromosome in the state of the last sample used.
 */
-static void probabilisticMutationOnlyActive(struct parameters *params, struct chromosome *chromo) {
+static double addSupervisedLearningErrors(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double error, double cutoff) {
 
 	int i, j;
-	int activeNode;
+	int blockSize;
+	int lastSample = 0;
+	double *columns;
+	double *outputs;
+	const double **operandColumns;
 
-	/* for every active node in the chromosome */
-	for (i = 0; i < chromo->numActiveNodes; i++) {
+	columns = (double*)malloc((chromo->numInputs + chromo->numActiveNodes) * SAMPLEBLOCKSIZE * sizeof(double));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
+	outputs = (double*)malloc(SAMPLEBLOCKSIZE * chromo->numOutputs * sizeof(double));
 
-		activeNode = chromo->activeNodes[i];
+	/* for each block of samples in data */
+	for (i = 0 ; i < getNumDataSetSamples(data); i += SAMPLEBLOCKSIZE) {
 
-		/* mutate the function gene */
-		if (randDecimal() <= params->mutationRate) {
-			chromo->nodes[activeNode]->function = getRandomFunction(chromo->funcSet->numFunctions);
-		}
+		blockSize = getNumDataSetSamples(data) - i < SAMPLEBLOCKSIZE ? getNumDataSetSamples(data) - i : SAMPLEBLOCKSIZE;
 
-		/* for every input to each chromosome */
-		for (j = 0; j < params->arity; j++) {
+		/* in the column layout the input columns are copied directly */
+		if (data->inputColumns != NULL && chromo->planIsFeedForward == 1) {
 
-			/* mutate the node input */
-			if (randDecimal() <= params->mutationRate) {
-				chromo->nodes[activeNode]->inputs[j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, activeNode, params->recurrentConnectionProbability);
+			for (j = 0; j < chromo->numInputs; j++) {
+				memcpy(columns + (j * SAMPLEBLOCKSIZE), data->inputColumns + ((size_t)j * data->columnStride) + i, blockSize * sizeof(double));
 			}
 
-			/* mutate the node connection weight */
-			if (randDecimal() <= params->mutationRate) {
-				chromo->nodes[activeNode]->weights[j] = getRandomConnectionWeight(params->connectionWeightRange);
-			}
+			executePlanColumns(chromo, blockSize, columns, operandColumns, chromo->nodeInputsHold, outputs);
+
+			lastSample = i + blockSize - 1;
 		}
-	}
 
-	/* for every chromosome output */
-	for (i = 0; i < params->numOutputs; i++) {
+		/* calculate the chromosome outputs for the block of inputs */
+		else {
+			executeChromosomeBlock(chromo, (const double **)(data->inputData + i), blockSize, columns, operandColumns, outputs);
+		}
 
-		/* mutate the chromosome output */
-		if (randDecimal() <= params->mutationRate) {
-			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections);
+		error = addSampleErrors(params, error, outputs, data->outputData + i, blockSize, chromo->numOutputs);
+
+		/* the error can only increase, the chromosome is rejected */
+		if (error > cutoff) {
+			break;
 		}
 	}
-}
 
+	/* leave the chromosome in the state of the last sample used */
+	if (data->inputColumns != NULL && chromo->planIsFeedForward == 1 && getNumDataSetSamples(data) > 0) {
+		executeChromosome(chromo, data->inputData[lastSample]);
+	}
 
+	free(columns);
+	free(operandColumns);
+	free(outputs);
 
-/*
-	Sets the random number seed
-*/
-DLL_EXPORT void setRandomNumberSeed(unsigned int seed) {
-	srand(seed);
+	return error;
 }
 
 
 /*
-	repetitively applies runCGP to obtain average behaviour
+	supervisedLearning on a streamed dataSet in double precision, reading
+	one block of samples at a time while the next is read ahead.
 */
-DLL_EXPORT struct results* repeatCGP(struct parameters *params, struct dataSet *data, int numGens, int numRuns) {
+static double supervisedLearningStreamed(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
 
 	int i;
-	struct results *rels;
-	int updateFrequency = params->updateFrequency;
-
-	/* set the update frequency so as to to so generational results */
-	params->updateFrequency = 0;
+	double error = 0;
+	struct dataSetBlock block;
 
-	rels = initialiseResults(params, numRuns);
+	initialiseDataSetBlock(data, &block);
 
-	printf("Run\tFitness\t\tGenerations\tActive Nodes\n");
+	for (i = 0; i < getNumDataSetBlocks(data); i++) {
 
-	/* for each run */
-	#pragma omp parallel for default(none), shared(numRuns,rels,params,data,numGens), schedule(dynamic), num_threads(params->numThreads)
-	for (i = 0; i < numRuns; i++) {
+		prefetchDataSetBlock(data, i + 1);
+		readDataSetBlock(data, i, &block);
 
-		/* run cgp */
-		rels->bestChromosomes[i] = runCGP(params, data, numGens);
+		error = addSupervisedLearningErrors(params, chromo, &block.view, error, cutoff);
 
-		printf("%d\t%f\t%d\t\t%d\n", i, rels->bestChromosomes[i]->fitness, rels->bestChromosomes[i]->generation, rels->bestChromosomes[i]->numActiveNodes);
+		/* the error can only increase, the chromosome is rejected */
+		if (error > cutoff) {
+			break;
+		}
 	}
 
-	printf("----------------------------------------------------\n");
-	printf("MEAN\t%f\t%f\t%f\n", getAverageFitness(rels), getAverageGenerations(rels), getAverageActiveNodes(rels));
-	printf("MEDIAN\t%f\t%f\t%f\n", getMedianFitness(rels), getMedianGenerations(rels), getMedianActiveNodes(rels));
-	printf("----------------------------------------------------\n\n");
-
-	/* restore the original value for the update frequency */
-	params->updateFrequency = updateFrequency;
+	freeDataSetBlock(&block);
 
-	return rels;
+	return error;
 }
 
 
-DLL_EXPORT struct chromosome* runCGP(struct parameters *params, struct dataSet *data, int numGens) {
-
-	int i;
-	int gen;
+/*
+	Adds the error of numSamples samples to the given error and returns the
+	sum. The error of each sample is the sum of the absolute differences
+	between the outputs and the targets, or the sample fitness function if
+	one is set. The errors are added in sample order so the sum does not
+	depend on how the samples were shared between threads.
+*/
+static double addSampleErrors(struct parameters *params, double error, const double *outputs, double **targets, int numSamples, int numOutputs) {
 
-	/* bestChromo found using runCGP */
-	struct chromosome *bestChromo;
+	int j, k;
 
-	/* arrays of the parents and children */
-	struct chromosome **parentChromos;
-	struct chromosome **childrenChromos;
+	if (params->sampleFitnessFunction != NULL) {
 
-	/* storage for chromosomes used by selection scheme */
-	struct chromosome **candidateChromos;
-	int numCandidateChromos;
+		for (k = 0; k < numSamples; k++) {
+			error += params->sampleFitnessFunction(numOutputs, outputs + (k * numOutputs), targets[k]);
+		}
 
-	/* error checking */
-	if (numGens < 0) {
-		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
-		exit(0);
+		return error;
 	}
 
-	if (data != NULL && params->numInputs != data->numInputs) {
-		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", data->numInputs, params->numInputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
+	/* for each sample */
+	for (k = 0; k < numSamples; k++) {
 
-	if (data != NULL && params->numOutputs != data->numOutputs) {
-		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", data->numOutputs, params->numOutputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+		/* for each chromosome output */
+		for (j = 0; j < numOutputs; j++) {
+			error += fabs(outputs[(k * numOutputs) + j] - targets[k][j]);
+		}
 	}
 
-	/* initialise parent chromosomes */
-	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+	return error;
+}
 
-	for (i = 0; i < params->mu; i++) {
-		parentChromos[i] = initialiseChromosome(params);
-	}
 
-	/* initialise children chromosomes */
-	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
+/*
+	Returns one if the samples of a dataSet can be shared between threads
+	when evaluating the given chromosome; either tasks of the current
+	OpenMP team or of a team of numThreads started for the chromosome. The
+	dataSet must be large enough to be worth splitting and the chromosome
+	feed-forward and deterministic.
+*/
+static int canSplitSampleBlocks(struct parameters *params, struct chromosome *chromo, int numSamples) {
 
-	for (i = 0; i < params->lambda; i++) {
-		childrenChromos[i] = initialiseChromosome(params);
+#ifdef _OPENMP
+	if (omp_in_parallel() == 0 ? params->numThreads < 2 : omp_get_num_threads() < 2) {
+		return 0;
 	}
 
-	/* intilise best chromosome */
-	bestChromo = initialiseChromosome(params);
-
-	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
-	if (params->evolutionaryStrategy == '+') {
-		numCandidateChromos = params->mu + params->lambda;
-	}
-	else if (params->evolutionaryStrategy == ',') {
-		numCandidateChromos = params->lambda;
-	}
-	else {
-		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
-		exit(0);
-	}
+	return numSamples >= 2 * SAMPLETASKBLOCKS * SAMPLEBLOCKSIZE && chromo->planIsFeedForward == 1 && chromosomeIsDeterministic(chromo) == 1;
+#else
+	(void)params;
+	(void)chromo;
+	(void)numSamples;
+	return 0;
+#endif
+}
 
-	/* initialise the candidateChromos */
-	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
 
-	for (i = 0; i < numCandidateChromos; i++) {
-		candidateChromos[i] = initialiseChromosome(params);
-	}
+/*
+	supervisedLearning with the samples shared between tasks of the
+	current OpenMP team, or of a team started if the caller is not already
+	running in one, in single precision if useFloat is one. The samples
+	are executed in waves of one task of
+	SAMPLETASKBLOCKS blocks per thread and the error is then summed in
+	sample order, a block at a time, so the fitness and the point at which
+	the chromosome is rejected are exactly as when not split.
+*/
+static double supervisedLearningTasks(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff, int useFloat) {
 
-	/* set fitness of the parents */
-	for (i = 0; i < params->mu; i++) {
-		setChromosomeFitness(params, parentChromos[i], data);
-	}
+	struct sampleEvaluation evaluation = {params, chromo, data, cutoff, useFloat, 0};
 
-	/* show the user whats going on */
-	if (params->updateFrequency != 0) {
-		printf("\n-- Starting CGP --\n\n");
-		printf("Gen\tfitness\n");
-	}
+	runInTeam(params->numThreads, supervisedLearningWaves, &evaluation);
 
-	/* for each generation */
-	for (gen = 0; gen < numGens; gen++) {
+	return evaluation.error;
+}
 
-		/* set fitness of the children of the population */
-		#pragma omp parallel for default(none), shared(params, childrenChromos,data), schedule(dynamic), num_threads(params->numThreads)
-		for (i = 0; i < params->lambda; i++) {
-			setChromosomeFitness(params, childrenChromos[i], data);
-		}
 
-		/* get best chromosome */
-		getBestChromosome(parentChromos, childrenChromos, params->mu, params->lambda, bestChromo);
+/*
+	Evaluates the chromosome as supervisedLearningTasks, in the current
+	team if running in one, setting the error of the evaluation
+*/
+static void supervisedLearningWaves(void *args) {
 
-		/* check termination conditions */
-		if (getChromosomeFitness(bestChromo) <= params->targetFitness) {
+	int i = 0;
+	int waveStart;
+	int waveSize = 0;
+	int taskStart;
+	int blockSize = 0;
+	int rejected = 0;
+	double error = 0;
+	double *outputs;
+	double *columns;
+	const double **operandColumns;
+	int maxWaveSize;
 
-			if (params->updateFrequency != 0) {
-				printf("%d\t%f - Solution Found\n", gen, bestChromo->fitness);
-			}
+	struct sampleEvaluation *evaluation = (struct sampleEvaluation*)args;
 
-			break;
-		}
+	struct parameters *params = evaluation->params;
+	struct chromosome *chromo = evaluation->chromo;
+	struct dataSet *data = evaluation->data;
+	double cutoff = evaluation->cutoff;
+	int useFloat = evaluation->useFloat;
 
-		/* display progress to the user at the update frequency specified */
-		if (params->updateFrequency != 0 && (gen % params->updateFrequency == 0 || gen >= numGens - 1) ) {
-			printf("%d\t%f\n", gen, bestChromo->fitness);
-		}
+	const int numSamples = getNumDataSetSamples(data);
+	const int numOutputs = chromo->numOutputs;
+	const int taskSize = SAMPLETASKBLOCKS * SAMPLEBLOCKSIZE;
 
-		/*
-			Set the chromosomes which will be used by the selection scheme
-			dependant upon the evolutionary strategy. i.e. '+' all are used
-			by the selection scheme, ',' only the children are.
-		*/
-		if (params->evolutionaryStrategy == '+') {
+	maxWaveSize = getNumTeamThreads() * taskSize;
 
-			/*
-				Note: the children are placed before the parents to
-				ensure 'new blood' is always selected over old if the
-				fitness are equal.
-			*/
+	outputs = (double*)malloc(maxWaveSize * numOutputs * sizeof(double));
 
-			for (i = 0; i < numCandidateChromos; i++) {
+	/* for each wave of tasks */
+	for (waveStart = 0; waveStart < numSamples && rejected == 0; waveStart += waveSize) {
 
-				if (i < params->lambda) {
-					copyChromosome(candidateChromos[i], childrenChromos[i] );
+		waveSize = numSamples - waveStart < maxWaveSize ? numSamples - waveStart : maxWaveSize;
+
+		for (taskStart = 0; taskStart < waveSize; taskStart += taskSize) {
+
+			#pragma omp task default(none), firstprivate(chromo, data, outputs, waveStart, waveSize, taskStart, taskSize, numOutputs, useFloat)
+			{
+				if (useFloat) {
+					executePlanSamplesFloat(chromo, data, waveStart + taskStart, waveSize - taskStart < taskSize ? waveSize - taskStart : taskSize, outputs + (taskStart * numOutputs));
 				}
 				else {
-					copyChromosome(candidateChromos[i], parentChromos[i - params->lambda] );
+					executePlanSamples(chromo, (const double **)(data->inputData + waveStart + taskStart), waveSize - taskStart < taskSize ? waveSize - taskStart : taskSize, outputs + (taskStart * numOutputs));
 				}
 			}
 		}
-		else if (params->evolutionaryStrategy == ',') {
-
-			for (i = 0; i < numCandidateChromos; i++) {
-				copyChromosome(candidateChromos[i], childrenChromos[i] );
-			}
-		}
 
-		/* select the parents from the candidateChromos */
-		params->selectionScheme(params, parentChromos, candidateChromos, params->mu, numCandidateChromos);
+		#pragma omp taskwait
 
-		/* create the children from the parents */
-		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda);
-	}
+		/* for each block of samples in the wave */
+		for (i = 0; i < waveSize && rejected == 0; i += SAMPLEBLOCKSIZE) {
 
-	/* deal with formatting for displaying progress */
-	if (params->updateFrequency != 0) {
-		printf("\n");
-	}
+			blockSize = waveSize - i < SAMPLEBLOCKSIZE ? waveSize - i : SAMPLEBLOCKSIZE;
 
-	/* copy the best best chromosome */
-	bestChromo->generation = gen;
-	/*copyChromosome(chromo, bestChromo);*/
+			error = addSampleErrors(params, error, outputs + (i * numOutputs), data->outputData + waveStart + i, blockSize, numOutputs);
 
-	/* free parent chromosomes */
-	for (i = 0; i < params->mu; i++) {
-		freeChromosome(parentChromos[i]);
+			/* the error can only increase, the chromosome is rejected */
+			rejected = error > cutoff;
+		}
 	}
-	free(parentChromos);
 
-	/* free children chromosomes */
-	for (i = 0; i < params->lambda; i++) {
-		freeChromosome(childrenChromos[i]);
-	}
-	free(childrenChromos);
+	/* leave the chromosome in the state of the last sample used, as supervisedLearning */
+	columns = (double*)malloc((chromo->numInputs + chromo->numActiveNodes) * SAMPLEBLOCKSIZE * sizeof(double));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
 
-	/* free the used chromosomes and population */
-	for (i = 0; i < numCandidateChromos; i++) {
-		freeChromosome(candidateChromos[i]);
-	}
-	free(candidateChromos);
+	executeChromosomeBlock(chromo, (const double **)(data->inputData + waveStart - waveSize + i - SAMPLEBLOCKSIZE), blockSize, columns, operandColumns, outputs);
 
-	return bestChromo;
+	free(columns);
+	free(operandColumns);
+	free(outputs);
+
+	evaluation->error = error;
 }
 
-/*
-	returns a pointer to the fittest chromosome in the two arrays of chromosomes
 
-	loops through parents and then the children in order for the children to always be selected over the parents
+/*
+	Returns one if the given node function is one of the Boolean node
+	functions, which give zero or one when given zeros and ones.
 */
-static void getBestChromosome(struct chromosome **parents, struct chromosome **children, int numParents, int numChildren, struct chromosome *best) {
-
-	int i;
-	struct chromosome *bestChromoSoFar;
+static int functionIsBoolean(double (*function)(const int numInputs, const double *inputs, const double *connectionWeights)) {
 
-	bestChromoSoFar = parents[0];
+	return function == _and || function == _nand || function == _or || function == _nor || function == _xor || function == _xnor || function == _not || function == _wire || function == _constOne || function == _constZero;
+}
 
-	for (i = 1; i < numParents; i++) {
 
-		if (parents[i]->fitness <= bestChromoSoFar->fitness) {
-			bestChromoSoFar = parents[i];
-		}
-	}
+/*
+	Returns one if every function in the function set is Boolean
+*/
+static int functionSetIsBoolean(struct parameters *params) {
 
-	for (i = 0; i < numChildren; i++) {
+	int i;
 
-		if (children[i]->fitness <= bestChromoSoFar->fitness) {
-			bestChromoSoFar = children[i];
+	for (i = 0; i < params->funcSet->numFunctions; i++) {
+		if (functionIsBoolean(params->funcSet->functions[i]) == 0) {
+			return 0;
 		}
 	}
 
-	copyChromosome(best, bestChromoSoFar);
+	return 1;
 }
 
 
 /*
-	copies the contents of funcSetSrc to funcSetDest
+	Returns one if the given chromosome is feed-forward and all its active
+	nodes are Boolean, so it can be evaluated bit-parallel.
 */
-static void copyFunctionSet(struct functionSet *funcSetDest, struct functionSet *funcSetSrc) {
+static int chromosomeIsBoolean(struct chromosome *chromo) {
 
 	int i;
 
-	funcSetDest->numFunctions = funcSetSrc->numFunctions;
+	if (chromo->planIsFeedForward == 0) {
+		return 0;
+	}
 
-	for (i = 0; i < funcSetDest->numFunctions; i++) {
-		strncpy(funcSetDest->functionNames[i], funcSetSrc->functionNames[i], FUNCTIONNAMELENGTH);
-		funcSetDest->functions[i] = funcSetSrc->functions[i];
-		funcSetDest->maxNumInputs[i] = funcSetSrc->maxNumInputs[i];
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		if (functionIsBoolean(chromo->planFunctions[i]) == 0) {
+			return 0;
+		}
 	}
+
+	return 1;
 }
 
 
 /*
-	copys the contents from the src node into dest node.
+	supervisedLearning for Boolean chromosomes on Boolean dataSets. Each
+	node is applied to BOOLEANBLOCKWORDS words of 64 samples at a time
+	using bitwise operations and the error is the number of output bits
+	which differ from the targets. The error is compared with the cutoff
+	every SAMPLEBLOCKSIZE samples, so the fitness and the point at which
+	the chromosome is rejected are exactly as supervisedLearning.
 */
-static void copyNode(struct node *nodeDest, struct node *nodeSrc) {
+static double supervisedLearningBoolean(struct chromosome *chromo, struct dataSet *data, double cutoff) {
 
-	int i;
+	int i, j, w;
+	int wordStart;
+	int numChunkWords;
+	int blockStart;
+	int blockEnd;
+	int lastSample = 0;
+	int rejected = 0;
+	double error = 0;
+	unsigned long long mask;
+	unsigned long long *nodeWords;
+	const unsigned long long *outputWords;
+	const unsigned long long *targetWords;
+	const unsigned long long **operandWords;
 
-	/* copy the node's function */
-	nodeDest->function = nodeSrc->function;
+	const int numSamples = data->numSamples;
+	const int numWords = (numSamples + 63) / 64;
+	const int numBlockWords = SAMPLEBLOCKSIZE / 64;
 
-	/* copy active flag */
-	nodeDest->active = nodeSrc->active;
+	nodeWords = (unsigned long long*)malloc(((size_t)chromo->numActiveNodes + 1) * BOOLEANBLOCKWORDS * sizeof(unsigned long long));
+	operandWords = malloc((chromo->arity + 1) * sizeof(*operandWords));
 
-	/* copy the node arity */
-	nodeDest->maxArity = nodeSrc->maxArity;
-	nodeDest->actArity = nodeSrc->actArity;
+	/* for each chunk of words */
+	for (wordStart = 0; wordStart < numWords && rejected == 0; wordStart += BOOLEANBLOCKWORDS) {
 
-	/* copy the nodes inputs and connection weights */
-	for (i = 0; i < nodeSrc->maxArity; i++) {
-		nodeDest->inputs[i] = nodeSrc->inputs[i];
-		nodeDest->weights[i] = nodeSrc->weights[i];
-	}
-}
+		numChunkWords = numWords - wordStart < BOOLEANBLOCKWORDS ? numWords - wordStart : BOOLEANBLOCKWORDS;
 
+		/* for each step in the execution plan */
+		for (i = 0; i < chromo->numActiveNodes; i++) {
 
-/*
-	mutate Random parent reproduction method.
-*/
-static void mutateRandomParent(struct parameters *params, struct chromosome **parents, struct chromosome **children, int numParents, int numChildren) {
+			for (j = 0; j < chromo->planArity[i]; j++) {
+				operandWords[j] = getBooleanColumn(chromo, data, nodeWords, chromo->planColumns[(i * chromo->arity) + j], wordStart);
+			}
 
-	int i;
+			executePlanStepBoolean(chromo, i, operandWords, nodeWords + ((size_t)i * BOOLEANBLOCKWORDS), numChunkWords);
+		}
 
-	/* for each child */
-	for (i = 0; i < numChildren; i++) {
+		/* for each block of samples in the chunk */
+		for (blockStart = 0; blockStart < numChunkWords && rejected == 0; blockStart += numBlockWords) {
 
-		/* set child as clone of random parent */
-		copyChromosome(children[i], parents[randInt(numParents)]);
+			blockEnd = numChunkWords - blockStart < numBlockWords ? numChunkWords : blockStart + numBlockWords;
 
-		/* mutate newly cloned child */
-		mutateChromosome(params, children[i]);
+			for (j = 0; j < chromo->numOutputs; j++) {
+
+				outputWords = getBooleanColumn(chromo, data, nodeWords, chromo->planOutputColumns[j], wordStart);
+				targetWords = data->outputBits + ((size_t)j * numWords) + wordStart;
+
+				for (w = blockStart; w < blockEnd; w++) {
+
+					/* ignore the bits past the last sample */
+					mask = wordStart + w == numWords - 1 && numSamples % 64 != 0 ? (1ULL << (numSamples % 64)) - 1 : ~0ULL;
+
+					error += countBits((outputWords[w] ^ targetWords[w]) & mask);
+				}
+			}
+
+			lastSample = (wordStart + blockEnd) * 64 < numSamples ? ((wordStart + blockEnd) * 64) - 1 : numSamples - 1;
+
+			/* the error can only increase, the chromosome is rejected */
+			rejected = error > cutoff;
+		}
 	}
+
+	free(nodeWords);
+	free(operandWords);
+
+	/* leave the chromosome in the state of the last sample used, as supervisedLearning */
+	executeChromosome(chromo, data->inputData[lastSample]);
+
+	return error;
 }
 
 
 /*
-	Selection scheme which selects the fittest members of the population
-	to be the parents.
+	Returns the words of the given column of the execution plan, a
+	chromosome input or step, starting from the given word of the dataSet.
+*/
+static const unsigned long long *getBooleanColumn(struct chromosome *chromo, struct dataSet *data, unsigned long long *nodeWords, int column, int wordStart) {
 
-	The candidateChromos contains the current children followed by the
- 	current parents. This means that using a stable sort to order
-	candidateChromos results in children being selected over parents if
-	their fitnesses are equal. A desirable property in CGP to facilitate
-	neutral genetic drift.
+	if (column < chromo->numInputs) {
+		return data->inputBits + ((size_t)column * ((data->numSamples + 63) / 64)) + wordStart;
+	}
+
+	return nodeWords + ((size_t)(column - chromo->numInputs) * BOOLEANBLOCKWORDS);
+}
+
+
+/*
+	Applies the given Boolean step of the execution plan to numWords words
+	of 64 samples. The xor and xnor node functions are one hot, as the
+	node functions are, rather than parity.
 */
-static void selectFittest(struct parameters *params, struct chromosome **parents, struct chromosome **candidateChromos, int numParents, int numCandidateChromos ) {
+BLOCKFUNCTIONTARGETS static void executePlanStepBoolean(struct chromosome *chromo, int step, const unsigned long long **operandWords, unsigned long long *nodeWords, const int numWords) {
 
-	int i;
+	int i, w;
+	unsigned long long one;
+	unsigned long long two;
 
-	sortChromosomeArray(candidateChromos, numCandidateChromos);
+	const int nodeArity = chromo->planArity[step];
+	double (*function)(const int numInputs, const double *inputs, const double *connectionWeights) = chromo->planFunctions[step];
 
-	for (i = 0; i < numParents; i++) {
-		copyChromosome(parents[i], candidateChromos[i]);
+	if (function == _constOne || function == _constZero) {
+
+		for (w = 0; w < numWords; w++) {
+			nodeWords[w] = function == _constOne ? ~0ULL : 0;
+		}
 	}
-}
 
+	else if (function == _and || function == _nand) {
 
+		for (w = 0; w < numWords; w++) {
+			nodeWords[w] = ~0ULL;
+		}
 
-/*
-	returns a pointer to an initialised node. Initialised means that necessary
-	memory has been allocated and values set.
-*/
-static struct node *initialiseNode(int numInputs, int numNodes, int arity, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition) {
+		for (i = 0; i < nodeArity; i++) {
+			for (w = 0; w < numWords; w++) {
+				nodeWords[w] &= operandWords[i][w];
+			}
+		}
+	}
 
-	struct node *n;
-	int i;
+	else if (function == _or || function == _nor) {
 
-	/* allocate memory for node */
-	n = (struct node*)malloc(sizeof(struct node));
+		for (w = 0; w < numWords; w++) {
+			nodeWords[w] = 0;
+		}
 
-	/* allocate memory for the node's inputs and connection weights */
-	n->inputs = (int*)malloc(arity * sizeof(int));
-	n->weights = (double*)malloc(arity * sizeof(double));
+		for (i = 0; i < nodeArity; i++) {
+			for (w = 0; w < numWords; w++) {
+				nodeWords[w] |= operandWords[i][w];
+			}
+		}
+	}
 
-	/* set the node's function */
-	n->function = getRandomFunction(numFunctions);
+	else if (function == _xor || function == _xnor) {
 
-	/* set as active by default */
-	n->active = 1;
+		/* the bits set by at least one and at least two inputs */
+		for (w = 0; w < numWords; w++) {
 
-	/* set the nodes inputs and connection weights */
-	for (i = 0; i < arity; i++) {
-		n->inputs[i] = getRandomNodeInput(numInputs, numNodes, nodePosition, recurrentConnectionProbability);
-		n->weights[i] = getRandomConnectionWeight(connectionWeightRange);
+			one = 0;
+			two = 0;
+
+			for (i = 0; i < nodeArity; i++) {
+				two |= one & operandWords[i][w];
+				one |= operandWords[i][w];
+			}
+
+			nodeWords[w] = one & ~two;
+		}
 	}
 
-	/* set the output of the node to zero*/
-	n->output = 0;
+	/* not and wire */
+	else {
+
+		for (w = 0; w < numWords; w++) {
+			nodeWords[w] = operandWords[0][w];
+		}
+	}
 
-	/* set the arity of the node */
-	n->maxArity = arity;
+	if (function == _nand || function == _nor || function == _xnor || function == _not) {
 
-	return n;
+		for (w = 0; w < numWords; w++) {
+			nodeWords[w] = ~nodeWords[w];
+		}
+	}
 }
 
 
 /*
-	Free memory associated with given node
+	Returns the number of set bits in the given word
 */
-static void freeNode(struct node *n) {
+static int countBits(unsigned long long bits) {
 
-	/* attempt to prevent user double freeing */
-	if (n == NULL) {
-		printf("Warning: double freeing of node prevented.\n");
-		return;
+#if defined(__GNUC__)
+	return __builtin_popcountll(bits);
+#else
+	int count = 0;
+
+	while (bits != 0) {
+		bits &= bits - 1;
+		count++;
 	}
 
-	free(n->inputs);
-	free(n->weights);
-	free(n);
+	return count;
+#endif
 }
 
+
 /*
-	returns a random connection weight value
+	Stores a single precision copy of the inputs of the given dataSet, one
+	column of numSamples values per input, if not already stored. The
+	copy is made once however many threads evaluate chromosomes at once.
 */
-static double getRandomConnectionWeight(double weightRange) {
-	return (randDecimal() * 2 * weightRange) - weightRange;
+static void setDataSetFloats(struct dataSet *data) {
+
+	int i, j;
+
+	#pragma omp critical (dataSetFloats)
+	{
+		if (data->inputFloats == NULL) {
+
+			data->inputFloats = (float*)malloc(((size_t)data->numInputs * data->numSamples + 1) * sizeof(float));
+
+			for (i = 0; i < data->numSamples; i++) {
+				for (j = 0; j < data->numInputs; j++) {
+					data->inputFloats[((size_t)j * data->numSamples) + i] = (float)data->inputData[i][j];
+				}
+			}
+		}
+	}
 }
 
+
 /*
-	returns a random function index
+	Returns one if the given chromosome is feed-forward and every active
+	node uses a preset node function other than rand, all of which have
+	a single precision version.
 */
-static int getRandomFunction(int numFunctions) {
+static int chromosomeHasFloatFunctions(struct chromosome *chromo) {
 
-	/* check that funcSet contains functions */
-	if (numFunctions < 1) {
-		printf("Error: cannot assign the function gene a value as the Function Set is empty.\nTerminating CGP-Library.\n");
-		exit(0);
+	int i;
+
+	if (chromo->planIsFeedForward == 0) {
+		return 0;
 	}
 
-	return randInt(numFunctions);
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		if (chromo->planBlockFunctions[i] == NULL) {
+			return 0;
+		}
+	}
+
+	return 1;
 }
 
+
 /*
-	returns a random input for the given node
+	supervisedLearning executing the chromosome in single precision. The
+	error is summed in double precision and compared with the cutoff
+	every SAMPLEBLOCKSIZE samples, as supervisedLearning.
 */
-static int getRandomNodeInput(int numChromoInputs, int numNodes, int nodePosition, double recurrentConnectionProbability) {
+static double supervisedLearningFloat(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
 
-	int input;
+	int i;
+	int blockSize;
+	int lastSample = 0;
+	double error = 0;
+	double *outputs;
+	float *columns;
+	float *weights;
+	const float **operandColumns;
 
-	/* pick any ahdead nodes or the node itself */
-	if (randDecimal() < recurrentConnectionProbability) {
-		input = randInt(numNodes - nodePosition) + nodePosition + 1;
+	columns = (float*)malloc(((size_t)chromo->numActiveNodes + 1) * SAMPLEBLOCKSIZE * sizeof(float));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
+	weights = (float*)malloc((chromo->arity + 1) * sizeof(float));
+	outputs = (double*)malloc(SAMPLEBLOCKSIZE * chromo->numOutputs * sizeof(double));
+
+	/* for each block of samples in data */
+	for (i = 0; i < data->numSamples; i += SAMPLEBLOCKSIZE) {
+
+		blockSize = data->numSamples - i < SAMPLEBLOCKSIZE ? data->numSamples - i : SAMPLEBLOCKSIZE;
+
+		executePlanBlockFloat(chromo, data, i, blockSize, columns, operandColumns, weights, outputs);
+
+		error = addSampleErrors(params, error, outputs, data->outputData + i, blockSize, chromo->numOutputs);
+
+		lastSample = i + blockSize - 1;
+
+		/* the error can only increase, the chromosome is rejected */
+		if (error > cutoff) {
+			break;
+		}
 	}
-	/* pick any previous node including inputs */
-	else {
-		input = randInt(numChromoInputs + nodePosition);
+
+	free(columns);
+	free(operandColumns);
+	free(weights);
+	free(outputs);
+
+	/* leave the chromosome in the state of the last sample used, in double precision */
+	if (data->numSamples > 0) {
+		executeChromosome(chromo, data->inputData[lastSample]);
 	}
 
-	return input;
+	return error;
 }
 
 
-/*
-	returns a random chromosome output
-*/
-static int getRandomChromosomeOutput(int numInputs, int numNodes, int shortcutConnections) {
+/*
+	Applies the execution plan of the given chromosome in single precision
+	to a block of at most SAMPLEBLOCKSIZE samples of the dataSet starting
+	at sampleStart, reading the inputs from the single precision copy of
+	the dataSet. The columns buffer holds SAMPLEBLOCKSIZE values for each
+	active node and the weights buffer arity values. The outputs are
+	written row by row in double precision. The chromosome is not changed.
+*/
+static void executePlanBlockFloat(struct chromosome *chromo, struct dataSet *data, int sampleStart, int numSamples, float *columns, const float **operandColumns, float *weights, double *outputs) {
+
+	int i, j, k;
+	int column;
+
+	const int numInputs = chromo->numInputs;
+	const int numOutputs = chromo->numOutputs;
+
+	/* for each step in the execution plan */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		for (j = 0; j < chromo->planArity[i]; j++) {
+
+			column = chromo->planColumns[(i * chromo->arity) + j];
+
+			if (column < numInputs) {
+				operandColumns[j] = data->inputFloats + ((size_t)column * data->numSamples) + sampleStart;
+			}
+			else {
+				operandColumns[j] = columns + ((column - numInputs) * SAMPLEBLOCKSIZE);
+			}
+
+			weights[j] = (float)chromo->planWeights[(i * chromo->arity) + j];
+		}
+
+		executePlanStepFloat(chromo, i, operandColumns, weights, columns + (i * SAMPLEBLOCKSIZE), numSamples);
+	}
 
-	int output;
+	/* gather the chromosome outputs */
+	for (j = 0; j < numOutputs; j++) {
 
-	if ( shortcutConnections == 1)
-		output = randInt(numInputs + numNodes);
-	else
-		output = randInt(numNodes) + numInputs;
+		column = chromo->planOutputColumns[j];
 
+		for (k = 0; k < numSamples; k++) {
 
-	return output;
+			if (column < numInputs) {
+				outputs[(k * numOutputs) + j] = data->inputFloats[((size_t)column * data->numSamples) + sampleStart + k];
+			}
+			else {
+				outputs[(k * numOutputs) + j] = columns[((column - numInputs) * SAMPLEBLOCKSIZE) + k];
+			}
+		}
+	}
 }
 
 
 /*
-	Node function add. Returns the sum of all the inputs.
+	Applies the execution plan of the given chromosome in single precision
+	to numSamples samples of the dataSet starting at sampleStart using
+	buffers of its own, writing the outputs row by row in double
+	precision. The chromosome is not changed.
 */
-static double _add(const int numInputs, const double *inputs, const double *connectionWeights) {
+static void executePlanSamplesFloat(struct chromosome *chromo, struct dataSet *data, int sampleStart, int numSamples, double *outputs) {
 
 	int i;
-	double sum = inputs[0];
+	int blockSize;
+	float *columns;
+	float *weights;
+	const float **operandColumns;
 
-	for (i = 1; i < numInputs; i++) {
-		sum += inputs[i];
+	columns = (float*)malloc(((size_t)chromo->numActiveNodes + 1) * SAMPLEBLOCKSIZE * sizeof(float));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
+	weights = (float*)malloc((chromo->arity + 1) * sizeof(float));
+
+	for (i = 0; i < numSamples; i += SAMPLEBLOCKSIZE) {
+
+		blockSize = numSamples - i < SAMPLEBLOCKSIZE ? numSamples - i : SAMPLEBLOCKSIZE;
+
+		executePlanBlockFloat(chromo, data, sampleStart + i, blockSize, columns, operandColumns, weights, outputs + (i * chromo->numOutputs));
 	}
 
-	return sum;
+	free(columns);
+	free(operandColumns);
+	free(weights);
 }
 
+
 /*
-	Node function sub. Returns the first input minus all remaining inputs.
+	Applies the given step of the execution plan to a block of samples in
+	single precision. Each preset node function is computed as its double
+	precision block version but using float arithmetic, twice as many
+	samples fitting in each vector register.
 */
-static double _sub(const int numInputs, const double *inputs, const double *connectionWeights) {
+BLOCKFUNCTIONTARGETS static void executePlanStepFloat(struct chromosome *chromo, int step, const float **operandColumns, const float *weights, float *nodeOutputs, const int numSamples) {
 
-	int i;
-	double sum = inputs[0];
+	int i, k;
 
-	for (i = 1; i < numInputs; i++) {
-		sum -= inputs[i];
-	}
+	const int nodeArity = chromo->planArity[step];
+	const float *x = operandColumns[0];
+	double (*function)(const int numInputs, const double *inputs, const double *connectionWeights) = chromo->planFunctions[step];
 
-	return sum;
-}
+	/* the arithmetic node functions apply the operation to each input in turn */
+	if (function == _add || function == _sub || function == _mul || function == _divide) {
 
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = x[k];
+		}
 
-/*
-	Node function mul. Returns the multiplication of all the inputs.
-*/
-static double _mul(const int numInputs, const double *inputs, const double *connectionWeights) {
+		for (i = 1; i < nodeArity; i++) {
 
-	int i;
-	double multiplication = inputs[0];
+			if (function == _add) {
+				for (k = 0; k < numSamples; k++) {
+					nodeOutputs[k] += operandColumns[i][k];
+				}
+			}
+			else if (function == _sub) {
+				for (k = 0; k < numSamples; k++) {
+					nodeOutputs[k] -= operandColumns[i][k];
+				}
+			}
+			else if (function == _mul) {
+				for (k = 0; k < numSamples; k++) {
+					nodeOutputs[k] *= operandColumns[i][k];
+				}
+			}
+			else {
+				for (k = 0; k < numSamples; k++) {
+					nodeOutputs[k] /= operandColumns[i][k];
+				}
+			}
+		}
+	}
 
-	for (i = 1; i < numInputs; i++) {
-		multiplication *= inputs[i];
+	else if (function == _absolute) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = fabsf(x[k]);
+		}
 	}
 
-	return multiplication;
-}
+	else if (function == _squareRoot) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = sqrtf(x[k]);
+		}
+	}
 
+	else if (function == _square) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = x[k] * x[k];
+		}
+	}
 
-/*
-	Node function div. Returns the first input divided by the second input divided by the third input etc
-*/
-static double _divide(const int numInputs, const double *inputs, const double *connectionWeights) {
+	else if (function == _cube) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = x[k] * x[k] * x[k];
+		}
+	}
 
-	int i;
-	double divide = inputs[0];
+	else if (function == _power) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = powf(x[k], operandColumns[1][k]);
+		}
+	}
 
-	for (i = 1; i < numInputs; i++) {
-		divide /= inputs[i];
+	else if (function == _exponential) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = expf(x[k]);
+		}
 	}
 
-	return divide;
-}
+	else if (function == _sine) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = sinf(x[k]);
+		}
+	}
 
+	else if (function == _cosine) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = cosf(x[k]);
+		}
+	}
 
-/*
-	Node function abs. Returns the absolute of the first input
-*/
-static double _absolute(const int numInputs, const double *inputs, const double *connectionWeights) {
+	else if (function == _tangent) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = tanf(x[k]);
+		}
+	}
 
-	return fabs(inputs[0]);
-}
+	else if (function == _wire) {
+		memcpy(nodeOutputs, x, numSamples * sizeof(float));
+	}
 
+	else if (function == _not) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = x[k] == 0 ? 1 : 0;
+		}
+	}
 
-/*
-	Node function sqrt.  Returns the square root of the first input
-*/
-static double _squareRoot(const int numInputs, const double *inputs, const double *connectionWeights) {
+	else if (function == _constOne || function == _constZero || function == _constPI) {
 
-	return sqrt(inputs[0]);
-}
+		const float value = function == _constOne ? 1 : function == _constZero ? 0 : (float)M_PI;
 
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = value;
+		}
+	}
 
-/*
-	Node function squ.  Returns the square of the first input
-*/
-static double _square(const int numInputs, const double *inputs, const double *connectionWeights) {
+	/* and and nand look for an input of '0', or and nor for an input of '1' */
+	else if (function == _and || function == _nand || function == _or || function == _nor) {
 
-	return pow(inputs[0], 2);
-}
+		const float match = function == _and || function == _nand ? 0 : 1;
+		const float found = function == _nand || function == _or ? 1 : 0;
 
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = 1 - found;
+		}
 
-/*
-	Node function cub.  Returns the cube of the first input
-*/
-static double _cube(const int numInputs, const double *inputs, const double *connectionWeights) {
+		for (i = 0; i < nodeArity; i++) {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] = operandColumns[i][k] == match ? found : nodeOutputs[k];
+			}
+		}
+	}
 
-	return pow(inputs[0], 3);
-}
+	/* the outputs are used to count the number of inputs which are '1' */
+	else if (function == _xor || function == _xnor) {
 
+		const float oneHot = function == _xor ? 1 : 0;
 
-/*
-	Node function power.  Returns the first output to the power of the second
-*/
-static double _power(const int numInputs, const double *inputs, const double *connectionWeights) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = 0;
+		}
 
-	return pow(inputs[0], inputs[1]);
-}
+		for (i = 0; i < nodeArity; i++) {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] += operandColumns[i][k] == 1;
+			}
+		}
 
-/*
-	Node function exp.  Returns the exponential of the first input
-*/
-static double _exponential(const int numInputs, const double *inputs, const double *connectionWeights) {
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = nodeOutputs[k] == 1 ? oneHot : 1 - oneHot;
+		}
+	}
 
-	return exp(inputs[0]);
-}
+	/* the neuron node functions apply an activation to the sum of the weighted inputs */
+	else {
 
+		for (k = 0; k < numSamples; k++) {
+			nodeOutputs[k] = 0;
+		}
 
-/*
-	Node function sin.  Returns the sine of the first input
-*/
-static double _sine(const int numInputs, const double *inputs, const double *connectionWeights) {
+		for (i = 0; i < nodeArity; i++) {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] += operandColumns[i][k] * weights[i];
+			}
+		}
 
-	return sin(inputs[0]);
+		if (function == _sigmoid) {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] = 1 / (1 + expf(-nodeOutputs[k]));
+			}
+		}
+		else if (function == _gaussian) {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] = expf(-(nodeOutputs[k] * nodeOutputs[k]) / 2);
+			}
+		}
+		else if (function == _step) {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] = nodeOutputs[k] < 0 ? 0 : 1;
+			}
+		}
+		else if (function == _softsign) {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] = nodeOutputs[k] / (1 + fabsf(nodeOutputs[k]));
+			}
+		}
+		else {
+			for (k = 0; k < numSamples; k++) {
+				nodeOutputs[k] = tanhf(nodeOutputs[k]);
+			}
+		}
+	}
+
+	for (k = 0; k < numSamples; k++) {
+		nodeOutputs[k] = sanitiseNodeOutputFloat(nodeOutputs[k]);
+	}
 }
 
+
 /*
-	Node function cos.  Returns the cosine of the first input
+	Prevents single precision node outputs becoming NAN, inf or -inf, as
+	sanitiseNodeOutput
 */
-static double _cosine(const int numInputs, const double *inputs, const double *connectionWeights) {
+static float sanitiseNodeOutputFloat(float nodeOutput) {
 
-	return cos(inputs[0]);
-}
+	if (isnan(nodeOutput) != 0) {
+		nodeOutput = 0;
+	}
 
-/*
-	Node function tan.  Returns the tangent of the first input
-*/
-static double _tangent(const int numInputs, const double *inputs, const double *connectionWeights) {
+	else if (isinf(nodeOutput) != 0) {
+		nodeOutput = nodeOutput > 0 ? FLT_MAX : FLT_MIN;
+	}
 
-	return tan(inputs[0]);
+	return nodeOutput;
 }
 
 
 /*
-	Node function one.  Always returns 1
+	Sets which steps of the given chromosomes execution plan compute
+	exactly the same values as a step of the reference chromosome. For
+	each step stepSource is set to the matching reference step, or -1 if
+	the step must be recomputed. A step matches if the node is active in
+	the reference with the same function, connections and used weights,
+	and all the nodes it connects to match. The steps which must be
+	recomputed are therefore the cone downstream of the changed genes.
+	Returns the number of steps which must be recomputed.
 */
-static double _constOne(const int numInputs, const double *inputs, const double *connectionWeights) {
-	return 1;
-}
+static int getIncrementalStepSources(struct chromosome *chromo, struct incrementalReference *ref, int *stepSource) {
 
-/*
-	Node function one.  Always returns 0
-*/
-static double _constZero(const int numInputs, const double *inputs, const double *connectionWeights) {
-	return 0;
-}
+	int i, j;
+	int nodeIndex;
+	int nodeArity;
+	int refStep;
+	int operandColumn;
+	int *refActiveNode;
+	int numChanged = 0;
 
-/*
-	Node function one.  Always returns PI
-*/
-static double _constPI(const int numInputs, const double *inputs, const double *connectionWeights) {
-	return M_PI;
-}
+	const int arity = chromo->arity;
+	const int numInputs = chromo->numInputs;
 
+	for (i = 0; i < chromo->numActiveNodes; i++) {
 
-/*
-	Node function rand.  Returns a random number between minus one and positive one
-*/
-static double _randFloat(const int numInputs, const double *inputs, const double *connectionWeights) {
+		nodeIndex = chromo->activeNodes[i];
+		nodeArity = chromo->planArity[i];
+		stepSource[i] = -1;
 
-	double random;
+		/* the rand node function gives different values every time */
+		if (ref != NULL && ref->chromo != NULL && ref->chromo->nodeActive[nodeIndex] == 1 && chromo->planFunctions[i] != _randFloat) {
 
-	random = (double)rand() / (double)RAND_MAX;
+			refActiveNode = (int*)bsearch(&nodeIndex, ref->chromo->activeNodes, ref->chromo->numActiveNodes, sizeof(int), cmpInt);
+			refStep = (int)(refActiveNode - ref->chromo->activeNodes);
 
-	random = (random * 2) - 1;
+			stepSource[i] = refStep;
 
-	return random;
-}
+			if (chromo->nodeFunctions[nodeIndex] != ref->chromo->nodeFunctions[nodeIndex] || nodeArity != ref->chromo->planArity[refStep]) {
+				stepSource[i] = -1;
+			}
+			else if (memcmp(chromo->planOperands + (i * arity), ref->chromo->planOperands + (refStep * arity), nodeArity * sizeof(int)) != 0) {
+				stepSource[i] = -1;
+			}
+			else if (planStepUsesWeights(chromo, i) && memcmp(chromo->planWeights + (i * arity), ref->chromo->planWeights + (refStep * arity), nodeArity * sizeof(double)) != 0) {
+				stepSource[i] = -1;
+			}
 
-/*
-	Node function and. logical AND, returns '1' if all inputs are '1'
-	else, '0'
-*/
-static double _and(const int numInputs, const double *inputs, const double *connectionWeights) {
+			/* the nodes connected to must also be unchanged */
+			for (j = 0; j < nodeArity && stepSource[i] != -1; j++) {
 
-	int i;
+				operandColumn = chromo->planColumns[(i * arity) + j];
 
-	for (i = 0; i < numInputs; i++) {
+				if (operandColumn >= numInputs && stepSource[operandColumn - numInputs] == -1) {
+					stepSource[i] = -1;
+				}
+			}
+		}
 
-		if (inputs[i] == 0) {
-			return 0;
+		if (stepSource[i] == -1) {
+			numChanged++;
 		}
 	}
 
-	return 1;
+	return numChanged;
 }
 
+
 /*
-	Node function and. logical NAND, returns '0' if all inputs are '1'
-	else, '1'
-*/
-static double _nand(const int numInputs, const double *inputs, const double *connectionWeights) {
+	Returns the supervised learning fitness of the given feed forward
+	chromosome, recomputing only the nodes which differ from the given
+	reference and reading all other node values from the reference
+	columns. If ref is NULL every node is computed.
 
-	int i;
+	If fullColumns is not NULL it is filled with the values of every active
+	node for every sample, one column per step of the execution plan, so
+	the chromosome can become a reference itself.
 
-	for (i = 0; i < numInputs; i++) {
+	Evaluation stops early once the error exceeds the cutoff. The node
+	values and error are computed exactly as supervisedLearning
+	computes them, so the fitness is identical.
+*/
+static double supervisedLearningIncremental(struct parameters *params, struct chromosome *chromo, struct dataSet *data, struct incrementalReference *ref, double *fullColumns, double cutoff) {
 
-		if (inputs[i] == 0) {
-			return 1;
-		}
-	}
+	int i, j, k;
+	int blockStart;
+	int blockSize;
+	int column;
+	int inputStride;
+	double error = 0;
+	int *stepSource;
+	double *outputs;
+	double *inputColumns;
+	const double *blockInputs;
+	double *changedColumns;
+	double *nodeOutputs;
+	const double **stepColumns;
+	const double **operandColumns;
 
-	return 0;
-}
+	const int numInputs = chromo->numInputs;
+	const int numOutputs = chromo->numOutputs;
+	const int numActiveNodes = chromo->numActiveNodes;
+	const int numSamples = data->numSamples;
 
+	stepSource = (int*)malloc((numActiveNodes + 1) * sizeof(int));
+	outputs = (double*)malloc(SAMPLEBLOCKSIZE * numOutputs * sizeof(double));
+	inputColumns = (double*)malloc(numInputs * SAMPLEBLOCKSIZE * sizeof(double));
+	changedColumns = (double*)malloc((numActiveNodes + 1) * SAMPLEBLOCKSIZE * sizeof(double));
+	stepColumns = malloc((numActiveNodes + 1) * sizeof(*stepColumns));
+	operandColumns = malloc((chromo->arity + 1) * sizeof(*operandColumns));
 
-/*
-	Node function or. logical OR, returns '0' if all inputs are '0'
-	else, '1'
-*/
-static double _or(const int numInputs, const double *inputs, const double *connectionWeights) {
+	getIncrementalStepSources(chromo, ref, stepSource);
 
-	int i;
+	/* for each block of samples in data */
+	for (blockStart = 0; blockStart < numSamples; blockStart += SAMPLEBLOCKSIZE) {
 
-	for (i = 0; i < numInputs; i++) {
+		blockSize = numSamples - blockStart < SAMPLEBLOCKSIZE ? numSamples - blockStart : SAMPLEBLOCKSIZE;
 
-		if (inputs[i] == 1) {
-			return 1;
+		/* in the column layout the inputs are read in place, otherwise one column per chromosome input */
+		if (data->inputColumns != NULL) {
+			blockInputs = data->inputColumns + blockStart;
+			inputStride = data->columnStride;
 		}
-	}
+		else {
 
-	return 0;
-}
+			for (k = 0; k < blockSize; k++) {
+				for (j = 0; j < numInputs; j++) {
+					inputColumns[(j * SAMPLEBLOCKSIZE) + k] = data->inputData[blockStart + k][j];
+				}
+			}
 
+			blockInputs = inputColumns;
+			inputStride = SAMPLEBLOCKSIZE;
+		}
 
-/*
-	Node function nor. logical NOR, returns '1' if all inputs are '0'
-	else, '0'
-*/
-static double _nor(const int numInputs, const double *inputs, const double *connectionWeights) {
+		for (i = 0; i < numActiveNodes; i++) {
+
+			/* unchanged nodes are read from the reference */
+			if (stepSource[i] != -1) {
+				stepColumns[i] = ref->columns + ((size_t)stepSource[i] * ref->numSamples) + blockStart;
+				continue;
+			}
 
-	int i;
+			for (j = 0; j < chromo->planArity[i]; j++) {
 
-	for (i = 0; i < numInputs; i++) {
+				column = chromo->planColumns[(i * chromo->arity) + j];
 
-		if (inputs[i] == 1) {
-			return 0;
-		}
-	}
+				if (column < numInputs) {
+					operandColumns[j] = blockInputs + ((size_t)column * inputStride);
+				}
+				else {
+					operandColumns[j] = stepColumns[column - numInputs];
+				}
+			}
 
-	return 1;
-}
+			if (fullColumns != NULL) {
+				nodeOutputs = fullColumns + ((size_t)i * numSamples) + blockStart;
+			}
+			else {
+				nodeOutputs = changedColumns + (i * SAMPLEBLOCKSIZE);
+			}
 
+			executePlanStepBlock(chromo, i, operandColumns, chromo->nodeInputsHold, nodeOutputs, blockSize);
 
-/*
-	Node function xor. logical XOR, returns '1' iff one of the inputs is '1'
-	else, '0'. AKA 'one hot'.
-*/
-static double _xor(const int numInputs, const double *inputs, const double *connectionWeights) {
+			stepColumns[i] = nodeOutputs;
+		}
 
-	int i;
-	int numOnes = 0;
-	int out;
+		/* gather the chromosome outputs */
+		for (k = 0; k < blockSize; k++) {
 
-	for (i = 0; i < numInputs; i++) {
+			for (j = 0; j < numOutputs; j++) {
 
-		if (inputs[i] == 1) {
-			numOnes++;
+				column = chromo->planOutputColumns[j];
+
+				if (column < numInputs) {
+					outputs[(k * numOutputs) + j] = blockInputs[((size_t)column * inputStride) + k];
+				}
+				else {
+					outputs[(k * numOutputs) + j] = stepColumns[column - numInputs][k];
+				}
+			}
 		}
 
-		if (numOnes > 1) {
+		error = addSampleErrors(params, error, outputs, data->outputData + blockStart, blockSize, numOutputs);
+
+		/* the error can only increase, the chromosome is rejected */
+		if (error > cutoff) {
 			break;
 		}
 	}
 
-	if (numOnes == 1) {
-		out = 1;
-	}
-	else {
-		out = 0;
+	/* complete the columns of the unchanged nodes */
+	if (fullColumns != NULL) {
+
+		for (i = 0; i < numActiveNodes; i++) {
+
+			if (stepSource[i] != -1) {
+				memcpy(fullColumns + ((size_t)i * numSamples), ref->columns + ((size_t)stepSource[i] * ref->numSamples), numSamples * sizeof(double));
+			}
+		}
 	}
 
-	return out;
+	free(stepSource);
+	free(outputs);
+	free(inputColumns);
+	free(changedColumns);
+	free(stepColumns);
+	free(operandColumns);
+
+	return error;
 }
 
+
 /*
-	Node function xnor. logical XNOR, returns '0' iff one of the inputs is '1'
-	else, '1'.
+	Sets the fitness of the given chromosome incrementally from whichever
+	of the given references it differs least from.
 */
-static double _xnor(const int numInputs, const double *inputs, const double *connectionWeights) {
+static void setChromosomeFitnessIncremental(struct parameters *params, struct chromosome *chromo, struct dataSet *data, struct incrementalReference *refs, int numRefs, double cutoff) {
 
 	int i;
-	int numOnes = 0;
-	int out;
+	int numChanged;
+	int fewestChanged = -1;
+	int *stepSource;
+	struct incrementalReference *bestRef = NULL;
 
-	for (i = 0; i < numInputs; i++) {
+	stepSource = (int*)malloc((chromo->numActiveNodes + 1) * sizeof(int));
 
-		if (inputs[i] == 1) {
-			numOnes++;
-		}
+	for (i = 0; i < numRefs; i++) {
 
-		if (numOnes > 1) {
-			break;
+		if (refs[i].chromo == NULL) {
+			continue;
 		}
-	}
-
-	if (numOnes == 1) {
-		out = 0;
-	}
-	else {
-		out = 1;
-	}
 
-	return out;
-}
+		numChanged = getIncrementalStepSources(chromo, &refs[i], stepSource);
 
-/*
-	Node function not. logical NOT, returns '1' if first input is '0', else '1'
-*/
-static double _not(const int numInputs, const double *inputs, const double *connectionWeights) {
+		if (fewestChanged == -1 || numChanged < fewestChanged) {
+			fewestChanged = numChanged;
+			bestRef = &refs[i];
+		}
+	}
 
-	double out;
+	free(stepSource);
 
-	if (inputs[0] == 0) {
-		out = 1;
-	}
-	else {
-		out = 0;
-	}
+	resetChromosome(chromo);
 
-	return out;
+	chromo->fitness = supervisedLearningIncremental(params, chromo, data, bestRef, NULL, cutoff);
 }
 
 
 /*
-	Node function wire. simply acts as a wire returning the first input
+	Makes each of the given parents the reference used for incremental
+	evaluation. References to parents which are unchanged are kept, the
+	columns of other parents are computed incrementally from whichever
+	existing reference they differ least from. Parents with recurrent
+	connections cannot be references.
 */
-static double _wire(const int numInputs, const double *inputs, const double *connectionWeights) {
-
-	double out;
-
-	out = inputs[0];
+static void setIncrementalReferences(struct parameters *params, struct chromosome **parents, struct incrementalReference *refs, struct dataSet *data) {
 
-	return out;
-}
+	int i, j;
+	int numChanged;
+	int fewestChanged;
+	int *stepSource;
+	int *keptRef;
+	int *refIsKept;
+	struct incrementalReference *bestRef;
+	struct incrementalReference *newRefs;
+
+	newRefs = (struct incrementalReference*)malloc(params->mu * sizeof(struct incrementalReference));
+	keptRef = (int*)malloc(params->mu * sizeof(int));
+	refIsKept = (int*)calloc(params->mu, sizeof(int));
+
+	/* find the references of unchanged parents, each reference can only be kept once */
+	for (i = 0; i < params->mu; i++) {
 
+		keptRef[i] = -1;
 
-/*
-	Node function sigmoid. returns the sigmoid of the sum of weighted inputs.
-	The specific sigmoid function used in the logistic function.
-	range: [0,1]
-*/
-static double _sigmoid(const int numInputs, const double *inputs, const double *connectionWeights) {
+		setChromosomeActiveNodes(parents[i]);
 
-	double weightedInputSum;
-	double out;
+		for (j = 0; j < params->mu && keptRef[i] == -1; j++) {
 
-	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
+			if (refs[j].chromo != NULL && refIsKept[j] == 0 && chromosomesPhenotypicallyEqual(parents[i], refs[j].chromo)) {
+				keptRef[i] = j;
+				refIsKept[j] = 1;
+			}
+		}
+	}
 
-	out = 1 / (1 + exp(-weightedInputSum));
+	/* compute the columns of changed parents */
+	for (i = 0; i < params->mu; i++) {
 
-	return out;
-}
+		newRefs[i].chromo = NULL;
+		newRefs[i].columns = NULL;
+		newRefs[i].numSamples = data->numSamples;
 
-/*
-	Node function Gaussian. returns the Gaussian of the sum of weighted inputs.
-	range: [0,1]
-*/
-static double _gaussian(const int numInputs, const double *inputs, const double *connectionWeights) {
+		if (keptRef[i] != -1 || parents[i]->planIsFeedForward == 0) {
+			continue;
+		}
 
-	double weightedInputSum;
-	double out;
+		/* find the existing reference which differs least */
+		stepSource = (int*)malloc((parents[i]->numActiveNodes + 1) * sizeof(int));
+		fewestChanged = -1;
+		bestRef = NULL;
 
-	int centre = 0;
-	int width = 1;
+		for (j = 0; j < params->mu; j++) {
 
-	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
+			if (refs[j].chromo == NULL) {
+				continue;
+			}
 
-	out = exp(-(pow(weightedInputSum - centre, 2)) / (2 * pow(width, 2)));
+			numChanged = getIncrementalStepSources(parents[i], &refs[j], stepSource);
 
-	return out;
-}
+			if (fewestChanged == -1 || numChanged < fewestChanged) {
+				fewestChanged = numChanged;
+				bestRef = &refs[j];
+			}
+		}
 
+		free(stepSource);
 
-/*
-	Node function step. returns the step function of the sum of weighted inputs.
-	range: [0,1]
-*/
-static double _step(const int numInputs, const double *inputs, const double *connectionWeights) {
+		newRefs[i].chromo = initialiseChromosomeFromChromosome(parents[i]);
+		newRefs[i].columns = (double*)malloc(((size_t)parents[i]->numActiveNodes * data->numSamples + 1) * sizeof(double));
 
-	double weightedInputSum;
-	double out;
+		supervisedLearningIncremental(params, newRefs[i].chromo, data, bestRef, newRefs[i].columns, HUGE_VAL);
+	}
 
-	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
+	/* move the kept references across */
+	for (i = 0; i < params->mu; i++) {
 
-	if (weightedInputSum < 0) {
-		out = 0;
+		if (keptRef[i] != -1) {
+			newRefs[i] = refs[keptRef[i]];
+			refs[keptRef[i]].chromo = NULL;
+			refs[keptRef[i]].columns = NULL;
+		}
 	}
-	else {
-		out = 1;
+
+	/* replace the old references */
+	for (i = 0; i < params->mu; i++) {
+		freeIncrementalReference(&refs[i]);
+		refs[i] = newRefs[i];
 	}
 
-	return out;
+	free(newRefs);
+	free(keptRef);
+	free(refIsKept);
 }
 
 
 /*
-	Node function step. returns the step function of the sum of weighted inputs.
-	range: [-1,1]
+	Frees the chromosome and columns held by the given reference
 */
-static double _softsign(const int numInputs, const double *inputs, const double *connectionWeights) {
-
-	double weightedInputSum;
-	double out;
+static void freeIncrementalReference(struct incrementalReference *ref) {
 
-	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
+	if (ref->chromo != NULL) {
+		freeChromosome(ref->chromo);
+	}
 
-	out = weightedInputSum / (1 + fabs(weightedInputSum));
+	free(ref->columns);
 
-	return out;
+	ref->chromo = NULL;
+	ref->columns = NULL;
 }
 
 
 /*
-	Node function tanh. returns the tanh function of the sum of weighted inputs.
-	range: [-1,1]
+	returns a random decimal between [0,1)
 */
-static double _hyperbolicTangent(const int numInputs, const double *inputs, const double *connectionWeights) {
-
-	double weightedInputSum;
-	double out;
-
-	weightedInputSum = sumWeigtedInputs(numInputs, inputs, connectionWeights);
-
-	out = tanh(weightedInputSum);
+static double randDecimal(void) {
 
-	return out;
+	/* the top 53 bits fill the mantissa of a double */
+	return (double)(nextRandom(&randomState) >> 11) * (1.0 / 9007199254740992.0);
 }
 
 
 /*
-	Returns the sum of the weighted inputs.
+	returns the next value of the given xoshiro256** generator.
+	see: http://prng.di.unimi.it/xoshiro256starstar.c
 */
-static double sumWeigtedInputs(const int numInputs, const double *inputs, const double *connectionWeights) {
+static unsigned long long nextRandom(struct randomState *state) {
 
-	int i;
-	double weightedSum = 0;
+	unsigned long long *s = state->s;
+	unsigned long long result;
+	unsigned long long t;
 
-	for (i = 0; i < numInputs; i++) {
-		weightedSum += (inputs[i] * connectionWeights[i]);
-	}
+	result = s[1] * 5;
+	result = ((result << 7) | (result >> 57)) * 9;
 
-	return weightedSum;
-}
+	t = s[1] << 17;
 
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
 
+	s[2] ^= t;
+	s[3] = (s[3] << 45) | (s[3] >> 19);
 
+	return result;
+}
 
 
 /*
-	The default fitness function used by CGP-Library.
-	Simply assigns an error of the sum of the absolute differences between the target and actual outputs for all outputs over all samples
+	the splitmix64 finaliser, mixing the given bits
 */
-static double supervisedLearning(struct parameters *params, struct chromosome *chromo, struct dataSet *data) {
+static unsigned long long mixRandomBits(unsigned long long bits) {
 
-	int i, j;
-	double error = 0;
+	bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
 
-	/* error checking */
-	if (getNumChromosomeInputs(chromo) != getNumDataSetInputs(data)) {
-		printf("Error: the number of chromosome inputs must match the number of inputs specified in the dataSet.\n");
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
+	return bits ^ (bits >> 31);
+}
 
-	if (getNumChromosomeOutputs(chromo) != getNumDataSetOutputs(data)) {
-		printf("Error: the number of chromosome outputs must match the number of outputs specified in the dataSet.\n");
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
 
-	/* for each sample in data */
-	for (i = 0 ; i < getNumDataSetSamples(data); i++) {
+/*
+	Seeds the given generator with the given stream of the given seed
+	using splitmix64. Different streams start from unrelated states.
+*/
+static void seedRandomState(struct randomState *state, unsigned long long seed, unsigned long long stream) {
 
-		/* calculate the chromosome outputs for the set of inputs  */
-		executeChromosome(chromo, getDataSetSampleInputs(data, i));
+	int i;
 
-		/* for each chromosome output */
-		for (j = 0; j < getNumChromosomeOutputs(chromo); j++) {
+	seed ^= mixRandomBits(stream + 0x9E3779B97F4A7C15ULL);
 
-			error += fabs(getChromosomeOutput(chromo, j) - getDataSetSampleOutput(data, i, j));
-		}
+	for (i = 0; i < 4; i++) {
+		seed += 0x9E3779B97F4A7C15ULL;
+		state->s[i] = mixRandomBits(seed);
 	}
-
-	return error;
 }
 
-
 /*
-	returns a random decimal between [0,1]
+	Continues the FNV-1a hash of previous data with the given bytes.
+	Start from HASHOFFSETBASIS.
 */
-static double randDecimal(void) {
-	return (double)rand() / (double)RAND_MAX;
+static unsigned long long hashBytes(unsigned long long hash, const void *data, size_t numBytes) {
+
+	size_t i;
+	const unsigned char *bytes = (const unsigned char*)data;
+
+	for (i = 0; i < numBytes; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
 }
 
 /*
@@ -3930,25 +10380,118 @@ static void printFunctionSet(struct parameters *params) {
 
 /*
 	random integer between zero and n without modulo bias.
-	adapted from: http://zuttobenkyou.wordpress.com/2012/10/18/generating-random-numbers-without-modulo-bias/
+	values below 2^64 mod n are rejected so that every remainder is equally likely.
 */
 static int randInt(int n) {
 
-	int x;
-	int randLimit;
-	int randExcess;
+	unsigned long long x;
+	unsigned long long randExcess;
 
 	if (n == 0) {
 		return 0;
 	}
 
-	randExcess = (RAND_MAX % n) + 1;
-	randLimit = RAND_MAX - randExcess;
+	randExcess = (0 - (unsigned long long)n) % (unsigned long long)n;
 
 	do {
-		x = rand();
+		x = nextRandom(&randomState);
+	}
+	while (x < randExcess);
+
+	return (int)(x % (unsigned long long)n);
+}
+
+
+/*
+	Returns one if the given chromosome can be screened in single precision
+	before being evaluated with the given cutoff. Screening requires the
+	default fitness function in double precision, a finite cutoff and a
+	chromosome with single precision node functions which would not
+	otherwise be evaluated bit-parallel.
+*/
+static int canScreenChromosome(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
+
+	if (params->screening == 0 || params->precision != 64 || params->cutoffFitnessFunction != supervisedLearning || data == NULL || data->stream != NULL || cutoff == HUGE_VAL) {
+		return 0;
+	}
+
+	if (params->sampleFitnessFunction == NULL && data->inputBits != NULL && chromosomeIsBoolean(chromo)) {
+		return 0;
+	}
+
+	return chromosomeHasFloatFunctions(chromo);
+}
+
+
+/*
+	Evaluates the given chromosome in single precision. If its single
+	precision fitness exceeds the cutoff by more than the screening margin
+	the chromosome cannot be selected; its fitness is set to the single
+	precision fitness and one is returned. Otherwise zero is returned and the
+	chromosome must be evaluated in double precision.
+*/
+static int screenChromosome(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
+
+	double screenCutoff = cutoff + SCREENINGMARGIN * (fabs(cutoff) + 1);
+	double fitness;
+
+	setDataSetFloats(data);
+
+	resetChromosome(chromo);
+
+	if (canSplitSampleBlocks(params, chromo, getNumDataSetSamples(data))) {
+		fitness = supervisedLearningTasks(params, chromo, data, screenCutoff, 1);
+	}
+	else {
+		fitness = supervisedLearningFloat(params, chromo, data, screenCutoff);
+	}
+
+	if (fitness > screenCutoff) {
+		chromo->fitness = fitness;
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+	Adds one screened chromosome to the screening statistics, with the time
+	taken to screen it and, for the sample of screened out chromosomes, the
+	time taken to evaluate it in double precision, otherwise zero.
+*/
+static void addScreeningStatistics(struct parameters *params, int screenedOut, double screenTime, double exactTime) {
+
+	#pragma omp critical (screening)
+	{
+		params->numScreened++;
+		params->screenTime += screenTime;
+
+		if (screenedOut) {
+			params->numScreenedOut++;
+			params->screenedOutTime += screenTime;
+		}
+
+		if (exactTime > 0) {
+			params->sampledScreenTime += screenTime;
+			params->sampledExactTime += exactTime;
+		}
 	}
-	while (x > randLimit);
+}
+
 
-	return x % n;
+/*
+	Resets the screening statistics
+*/
+static void resetScreeningStatistics(struct parameters *params) {
+
+	#pragma omp critical (screening)
+	{
+		params->numScreened = 0;
+		params->numScreenedOut = 0;
+		params->screenTime = 0;
+		params->screenedOutTime = 0;
+		params->sampledScreenTime = 0;
+		params->sampledExactTime = 0;
+	}
 }
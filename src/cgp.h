@@ -144,6 +144,33 @@ extern "C" {
 		- The number of threads defines how many threads the CGP library
 		will use internally. See <setNumThreads>.
 
+		- The compile chromosomes flag controls whether chromosomes are
+		compiled to native code before being assigned a fitness.
+		See <setCompileChromosomes>.
+
+		- The reuse fitness flag controls whether <runCGP> reuses the
+		fitness of children identical in behaviour to an already
+		evaluated chromosome. See <setReuseFitness>.
+
+		- The fitness cache size is the maximum number of fitness values
+		kept between generations by <runCGP> and <repeatCGP>.
+		See <setFitnessCacheSize>.
+
+		- The incremental evaluation flag controls whether <runCGP>
+		evaluates children by recomputing only the nodes which differ
+		from a parent. See <setIncrementalEvaluation>.
+
+		- The precision is the precision in which the default fitness
+		function executes chromosomes, double or float. See <setPrecision>.
+
+		- The screening flag controls whether <runCGP> first evaluates
+		children in single precision, evaluating in double precision
+		only those which could be selected. See <setScreening>.
+
+		- The population evaluation flag controls whether <runCGP>
+		evaluates all of the children on each block of samples in turn.
+		See <setPopulationEvaluation>.
+
 	See Also:
 		<initialiseParameters>, <freeParameters>, <printParameters>
 */
@@ -167,8 +194,12 @@ struct chromosome;
 
 	Typically contains input output pairs of data used when applying CGP to supervised learning tasks.
 
+	The inputs and outputs are each stored in one contiguous buffer, sample by sample and aligned to 64 bytes, unless the dataSet is a view of arrays owned by the caller, see <initialiseDataSetView>. In the column layout they are also stored input by input and output by output, see <setDataSetLayout>. A streamed dataSet instead keeps its samples on disk, see <initialiseDataSetStream>.
+
+	If every input and output is zero or one the data set is also stored packed 64 samples to a word. The default supervised learning fitness function then evaluates feed-forward chromosomes whose active nodes are all Boolean node functions (and, nand, or, nor, xor, xnor, not, wire, 1 and 0) on 64 samples at a time using bitwise operations, counting the differing output bits. The fitness is identical but found much faster, for example when evolving digital circuits.
+
 	See Also:
-		<initialiseDataSetFromFile>, <initialiseDataSetFromArrays>, <freeDataSet>, <printDataSet>
+		<initialiseDataSetFromFile>, <initialiseDataSetFromArrays>, <initialiseDataSetView>, <initialiseDataSetStream>, <freeDataSet>, <printDataSet>
 */
 struct dataSet;
 
@@ -184,6 +215,18 @@ struct dataSet;
 */
 struct results;
 
+/*
+	variable: executionState
+
+	Stores the node values of one caller executing a chromosome using <executeChromosomeWithState>, so that many threads can execute the same chromosome at once.
+
+	See Also:
+
+		<initialiseExecutionState>, <freeExecutionState>, <resetExecutionState>, <executeChromosomeWithState>
+
+*/
+struct executionState;
+
 
 
 /*
@@ -665,6 +708,108 @@ DLL_EXPORT void setConnectionWeightRange(struct parameters *params, double weigh
 DLL_EXPORT void setCustomFitnessFunction(struct parameters *params, double (*fitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data), char const *fitnessFunctionName);
 
 
+/*
+	Function: setCustomFitnessFunctionWithCutoff
+
+	Set custom fitness function which may stop evaluating a chromosome early.
+
+	Most children are less fit than their parents and cannot be selected. When using the default select fittest selection scheme with the '+' evolutionary strategy, <runCGP> passes the fitness of the least fit parent as the cutoff; a child with a fitness greater than the cutoff cannot be selected. Once a fitness function can tell the fitness will exceed the cutoff, for example because the error summed so far already does, it may stop and return any value greater than the cutoff to reject the chromosome. Otherwise the cutoff is HUGE_VAL and the full fitness must be returned.
+
+	The default supervised learning fitness function stops early in this way. The same custom fitness functions as <setCustomFitnessFunction> can be used with the additional cutoff parameter.
+
+	(begin code)
+	double functionName(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+	(end)
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		fitnessFunction - the custom fitness function
+		fitnessFunctionName - name of custom fitness function
+
+		If the fitnessFunction parameter is set as NULL, the fitness function will be reset to the default supervised learning fitness function.
+
+	Example:
+
+		Stopping a sum of absolute errors once the chromosome is rejected.
+
+		(begin code)
+		double absoluteError(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff){
+
+			int i;
+			double error = 0;
+
+			for(i=0; i<getNumDataSetSamples(data); i++){
+
+				executeChromosome(chromo, getDataSetSampleInputs(data, i));
+
+				error += fabs(getChromosomeOutput(chromo, 0) - getDataSetSampleOutput(data, i, 0));
+
+				// the error can only increase, the chromosome is rejected
+				if(error > cutoff){
+					break;
+				}
+			}
+
+			return error;
+		}
+		(end)
+
+	See Also:
+		<setCustomFitnessFunction>, <setChromosomeFitness>
+*/
+DLL_EXPORT void setCustomFitnessFunctionWithCutoff(struct parameters *params, double (*fitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff), char const *fitnessFunctionName);
+
+
+/*
+	Function: setCustomSampleFitnessFunction
+
+	Set custom fitness function which is the sum of an error for each sample of the <dataSet>.
+
+	The sample fitness function is given the chromosome outputs and target outputs for one sample and returns the error for that sample, which must not be negative. The default supervised learning fitness function executes the chromosome and sums the sample errors, in sample order, in place of the absolute differences between the outputs and targets.
+
+	Unlike a fitness function set using <setCustomFitnessFunction>, the samples of large data sets can then be split between the threads set using <setNumThreads> to evaluate a single chromosome, and the chromosome is rejected early as described for <setCustomFitnessFunctionWithCutoff>. The sum is the same however the samples were split. The sample fitness function may be called from several threads at once so must be thread safe.
+
+	(begin code)
+	double functionName(const int numOutputs, const double *outputs, const double *targets);
+	(end)
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		sampleFitnessFunction - the custom sample fitness function
+		fitnessFunctionName - name of custom fitness function
+
+		If the sampleFitnessFunction parameter is set as NULL, the fitness function will be reset to the default supervised learning fitness function.
+
+	Example:
+
+		Counting the misclassified samples.
+
+		(begin code)
+		double misclassified(const int numOutputs, const double *outputs, const double *targets){
+
+			int i;
+
+			for(i=0; i<numOutputs; i++){
+				if((outputs[i] > 0) != (targets[i] > 0)){
+					return 1;
+				}
+			}
+
+			return 0;
+		}
+		(end)
+
+		Setting the new sample fitness function
+		(begin code)
+		setCustomSampleFitnessFunction(params, misclassified, "misclassified");
+		(end)
+
+	See Also:
+		<setCustomFitnessFunction>, <setCustomFitnessFunctionWithCutoff>
+*/
+DLL_EXPORT void setCustomSampleFitnessFunction(struct parameters *params, double (*sampleFitnessFunction)(const int numOutputs, const double *outputs, const double *targets), char const *fitnessFunctionName);
+
+
 /*
 	Function: setCustomSelectionScheme
 
@@ -681,6 +826,9 @@ DLL_EXPORT void setCustomFitnessFunction(struct parameters *params, double (*fit
 	Note:
 		The ordering of the candidateChromos is children followed by parents.
 
+	Note:
+		The candidateChromos and parents are separate copies, so a custom selection scheme copies the selected <chromosomes> into parents. The default select fittest selection scheme instead reorders the population in place, avoiding copying any <chromosomes>.
+
 	Parameters:
 
 		params - pointer to <parameters> structure
@@ -732,6 +880,40 @@ DLL_EXPORT void setCustomFitnessFunction(struct parameters *params, double (*fit
 DLL_EXPORT void setCustomSelectionScheme(struct parameters *params, void (*selectionScheme)(struct parameters *params, struct chromosome **parents, struct chromosome **candidateChromos, int numParents, int numCandidateChromos), char const *selectionSchemeName);
 
 
+/*
+	Function: getChromosomeRanking
+
+	Ranks the given array of chromosomes by fitness without reordering the array.
+
+	ranking is set to the indices of the chromosomes ordered from the lowest (fittest) to the highest fitness. Chromosomes with equal fitness keep their order in the array, so given the candidateChromos of a selection scheme children rank above parents of equal fitness. The ranking is found using a stable merge sort, taking O(n log n) time.
+
+	Parameters:
+		chromoArray - array of pointers to initialised chromosome structures.
+		numChromos - the number of chromosomes in chromoArray.
+		ranking - array of at least numChromos ints set to the ranked indices.
+
+	Example:
+
+		Selecting the fittest candidates in a custom selection scheme.
+
+		(begin code)
+		int *ranking = malloc(numCandidateChromos * sizeof(int));
+
+		getChromosomeRanking(candidateChromos, numCandidateChromos, ranking);
+
+		for(i=0; i<numParents; i++){
+			copyChromosome(parents[i], candidateChromos[ranking[i]]);
+		}
+
+		free(ranking);
+		(end)
+
+	See Also:
+		<setCustomSelectionScheme>, <getChromosomeFitness>
+*/
+DLL_EXPORT void getChromosomeRanking(struct chromosome **chromoArray, int numChromos, int *ranking);
+
+
 /*
 	Function: setCustomReproductionScheme
 
@@ -868,13 +1050,271 @@ DLL_EXPORT void setUpdateFrequency(struct parameters *params, int updateFrequenc
 
 	Note:
 		The CGP-Library ignores the OMP_NUM_THREADS environment variable. The
-		only method for setting the number of threads is using <setNumThreads>.
+		only method for setting the number of threads is using <setNumThreads>,
+		or <setDataSetParsingThreads> for parsing text <dataSet> files.
+
+	Note:
+		When the children are cheap to evaluate, starting the threads can take
+		longer than evaluating the children serially. <runCGP> times both and
+		evaluates each generation whichever way has been faster, so setting
+		more threads never makes small tasks much slower. The threads are kept
+		by the OpenMP runtime between generations. How idle threads wait and
+		which cores they use can be set using the OMP_WAIT_POLICY,
+		OMP_PROC_BIND and OMP_PLACES environment variables.
+
+	Note:
+		The threads are shared between the runs of <repeatCGP>, the children
+		of each generation and, for large data sets, blocks of samples, all
+		as tasks of one team. All the threads are therefore kept busy whether
+		there are few runs, few children or many samples. Samples are only
+		shared between threads for feed-forward chromosomes without a rand
+		node, using the default fitness function or one set using
+		<setCustomSampleFitnessFunction>. Custom node functions may then be
+		called from several threads at once.
 
 	Parameters:
 		params - pointer to <parameters> structure.
 		numThreads - The number of threads to be set.
 */
-DLL_EXPORT void setNumThreads(struct parameters *params, int numThreads);
+DLL_EXPORT void setNumThreads(struct parameters *params, int numThreads);
+
+
+/*
+	Function: setCompileChromosomes
+
+	Sets whether chromosomes are compiled to native code before being assigned a fitness.
+
+	When set, each chromosome is compiled using <compileChromosome> before the fitness function is called, so that all calls to <executeChromosome> made by the fitness function run native code. Compiling a chromosome takes far longer than executing it a few times, so this is only worthwhile for fitness functions which execute each chromosome many thousands of times. Compiled chromosomes are cached, so parents which are carried over between generations are not compiled again. The default fitness function executes feed-forward chromosomes a block of samples at a time without calling <executeChromosome>, so only recurrent chromosomes are compiled when it is used.
+
+	Values other than 0 (no) and 1 (yes) are invalid. If an invalid value is given a warning is displayed and the value is left unchanged. The default is 0.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		compileChromosomes - whether chromosomes are compiled.
+
+	See Also:
+		<compileChromosome>
+*/
+DLL_EXPORT void setCompileChromosomes(struct parameters *params, int compileChromosomes);
+
+
+/*
+	Function: setReuseFitness
+
+	Sets whether <runCGP> reuses the fitness of children whose active genotype matches an already evaluated chromosome.
+
+	Most mutations only change inactive genes, producing children which behave identically to their parent. When set, each child whose active nodes, node functions, used connections, output genes and (for node functions using them) connection weights match a parent or another child of the same generation takes that chromosomes fitness instead of being evaluated. The number of evaluations saved is given by <getChromosomeSavedEvaluations>.
+
+	This assumes the fitness function is deterministic, depending only on the active genes of the chromosome. Chromosomes using the rand node function are always evaluated. Fitness reuse also turns on the fitness cache, see <setFitnessCacheSize>.
+
+	By default fitness values are reused when the default fitness function is used, which only depends on the active genes, and are not reused when a custom fitness function has been set using <setCustomFitnessFunction>, <setCustomFitnessFunctionWithCutoff> or <setCustomSampleFitnessFunction>, as these may be stochastic or depend on inactive genes. Setting 0 turns fitness reuse off whatever the fitness function, and should be used if the default fitness function is used with a data set which changes between generations. Setting 1 turns it on whatever the fitness function, which is only correct for deterministic fitness functions depending only on the active genes.
+
+	Values other than 0 (no) and 1 (yes) are invalid. If an invalid value is given a warning is displayed and the value is left unchanged.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		reuseFitness - whether fitness values are reused.
+
+	See Also:
+		<runCGP>, <getChromosomeSavedEvaluations>
+*/
+DLL_EXPORT void setReuseFitness(struct parameters *params, int reuseFitness);
+
+
+/*
+	Function: setFitnessCacheSize
+
+	Sets the maximum number of fitness values kept by the fitness cache.
+
+	During neutral drift evolution often revisits chromosomes which behave identically to ones evaluated in earlier generations. <runCGP> and <repeatCGP> keep the fitness of recently evaluated chromosomes in a cache keyed by a hash of the active graph: the node functions, active connections, output genes and, for node functions which use them, the connection weights. Chromosomes found in the cache take the cached fitness instead of being evaluated. When the cache is full the least recently used fitness is discarded.
+
+	The hash only depends on the structure of the active graph, not on where the active nodes lie in the chromosome, so each cached fitness is stored with the chromosome's exact active genotype: the position, function and connections of each active node, its connection weights if used, and the output genes. A chromosome only takes a cached fitness if its active genotype is identical, so fitness functions which depend on the number or position of the active nodes, such as parsimony pressure, are given correct fitness values. As with <setReuseFitness>, the fitness function is assumed to be deterministic and to not depend on inactive genes; the cache is only used when fitness values are reused, which by default is only when the default fitness function is used. The cache is emptied at the start of <runCGP> and <repeatCGP>, with all the runs of <repeatCGP> sharing one cache.
+
+	Values <0 are invalid. If an invalid value is given a warning is displayed and the value is left unchanged. A size of 0 turns the cache off. The default is 10000.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		fitnessCacheSize - the maximum number of fitness values cached.
+
+	See Also:
+		<clearFitnessCache>, <getFitnessCacheHitRate>, <getFitnessCacheMemoryUsage>
+*/
+DLL_EXPORT void setFitnessCacheSize(struct parameters *params, int fitnessCacheSize);
+
+
+/*
+	Function: setIncrementalEvaluation
+
+	Sets whether <runCGP> evaluates children incrementally from their parents.
+
+	Most children differ from their parent in only a few active nodes. When set, the value of every active node of each parent is kept for every sample in the data set. A child is then evaluated by recomputing only the nodes whose function, inputs or weights differ from the most similar parent, and the nodes downstream of them; all other node values are taken from the parent. The fitness found is identical to that of a full evaluation.
+
+	Incremental evaluation is only used with the default fitness function and for feed forward chromosomes; recurrent chromosomes and custom fitness functions are evaluated in full. Keeping the node values of the parents requires memory proportional to the number of parents, active nodes and samples.
+
+	Values other than 0 (no) and 1 (yes) are invalid. If an invalid value is given a warning is displayed and the value is left unchanged. The default is 0.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		incrementalEvaluation - whether children are evaluated incrementally.
+
+	See Also:
+		<runCGP>, <setReuseFitness>
+*/
+DLL_EXPORT void setIncrementalEvaluation(struct parameters *params, int incrementalEvaluation);
+
+
+/*
+	Function: setPrecision
+
+	Sets the precision in which the default fitness function executes chromosomes.
+
+	The valid precisions are 'double', the default, and 'float'. In float precision the data set inputs, node values and connection weights are held as single precision floats, so twice as many samples are processed by each vector instruction and half as much memory is read. The error is still summed in double precision. A single precision copy of the data set inputs is made when first used and kept with the data set.
+
+	The fitness found in float precision differs slightly from that in double precision and node outputs overflow at FLT_MAX rather than DBL_MAX. Only the fitness is affected; <executeChromosome> and all other functions use double precision. Chromosomes using custom node functions, the rand node function or recurrent connections, and custom fitness functions other than <setCustomSampleFitnessFunction>, are always evaluated in double precision. <setIncrementalEvaluation> is ignored in float precision.
+
+	If an invalid precision is given a warning is displayed and the precision is left unchanged. Changing the precision clears the fitness cache.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		precision - the precision, 'double' or 'float'.
+
+	Example:
+
+		(begin code)
+		setPrecision(params, "float");
+		(end)
+*/
+DLL_EXPORT void setPrecision(struct parameters *params, char const *precision);
+
+
+/*
+	Function: setScreening
+
+	Sets whether <runCGP> screens children in single precision before evaluating them in double precision.
+
+	When set, each child which must be evaluated is first evaluated by the default fitness function in float precision, see <setPrecision>, stopping early once its fitness is certain to be worse than the fitness needed to be selected. Children whose single precision fitness is worse by more than a small margin (0.1% of that fitness plus 0.001) are rejected without being evaluated further. Only the remaining children are evaluated in double precision, so every chromosome which can be selected, and every fitness reported, is exact.
+
+	A child whose single precision fitness differs from its double precision fitness by more than the margin may be wrongly rejected; this is rare for well conditioned chromosomes. Screening saves time when most children are rejected, the common case, and costs time when most are not. The fraction of children screened out and the time saved are given by <getScreenedOutFraction> and <getScreeningTimeSaved> and are displayed at the end of <runCGP> and <repeatCGP>.
+
+	Screening is only used with the default fitness function in double precision and for chromosomes which would otherwise be evaluated in float precision; other chromosomes, and parents, are evaluated in double precision only.
+
+	Values other than 0 (no) and 1 (yes) are invalid. If an invalid value is given a warning is displayed and the value is left unchanged. The default is 0.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		screening - whether children are screened in single precision.
+
+	See Also:
+		<runCGP>, <setPrecision>
+*/
+DLL_EXPORT void setScreening(struct parameters *params, int screening);
+
+
+/*
+	Function: setPopulationEvaluation
+
+	Sets whether <runCGP> evaluates all of the children of a generation on each block of samples in turn, rather than each child on every sample in turn.
+
+	When set, the default fitness function executes every child on a block of 128 samples before moving on to the next block, so each block is loaded into cache once per generation rather than once per child. This saves time when the <dataSet> is too large to stay in the processor's cache. With more than one thread, see <setNumThreads>, the blocks are shared between the threads and the error of each child is then summed in sample order, so the fitness found, and the point at which a child is rejected as unable to be selected, are identical to evaluating each child alone.
+
+	Children which are recurrent, use the rand node function or are evaluated bit-parallel on Boolean data sets are evaluated alone. Screening and incremental evaluation are not used while population evaluation is set. Streamed data sets, see <initialiseDataSetStream>, are always evaluated a block at a time for all of the children.
+
+	Values other than 0 (no) and 1 (yes) are invalid. If an invalid value is given a warning is displayed and the value is left unchanged. The default is 0.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		populationEvaluation - whether all the children are evaluated on each block of samples in turn.
+
+	See Also:
+		<runCGP>, <setNumThreads>
+*/
+DLL_EXPORT void setPopulationEvaluation(struct parameters *params, int populationEvaluation);
+
+
+/*
+	Function: getScreenedOutFraction
+
+	Gets the fraction of the children screened in single precision which were rejected without being evaluated in double precision, since the start of the last <runCGP> or <repeatCGP>.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+
+	Returns:
+		The fraction of screened children rejected, between 0 and 1.
+
+	See Also:
+		<setScreening>, <getScreeningTimeSaved>
+*/
+DLL_EXPORT double getScreenedOutFraction(struct parameters *params);
+
+
+/*
+	Function: getScreeningTimeSaved
+
+	Gets an estimate of the evaluation time saved by screening since the start of the last <runCGP> or <repeatCGP>, summed over all threads.
+
+	One in 32 of the rejected children, chosen by their genotype, is also evaluated in double precision. The double precision evaluations avoided are estimated from the time taken to screen the rejected children, scaled by the ratio of double precision to single precision evaluation time of this sample. The time spent screening and evaluating the sample is subtracted, so the estimate is negative if screening cost more than it saved.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+
+	Returns:
+		The estimated time saved in seconds, or 0 if no rejected child has yet been evaluated in double precision.
+
+	See Also:
+		<setScreening>, <getScreenedOutFraction>
+*/
+DLL_EXPORT double getScreeningTimeSaved(struct parameters *params);
+
+
+/*
+	Function: clearFitnessCache
+
+	Empties the fitness cache of the given <parameters> and resets its statistics.
+
+	The cache is cleared automatically at the start of <runCGP> and <repeatCGP> and when the fitness function is changed using <setCustomFitnessFunction>.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+
+	See Also:
+		<setFitnessCacheSize>
+*/
+DLL_EXPORT void clearFitnessCache(struct parameters *params);
+
+
+/*
+	Function: getFitnessCacheHitRate
+
+	Gets the fraction of fitness cache lookups which found a fitness since the cache was last cleared.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+
+	Returns:
+		The fitness cache hit rate between 0 and 1.
+
+	See Also:
+		<setFitnessCacheSize>, <getFitnessCacheMemoryUsage>
+*/
+DLL_EXPORT double getFitnessCacheHitRate(struct parameters *params);
+
+
+/*
+	Function: getFitnessCacheMemoryUsage
+
+	Gets the number of bytes of memory used by the fitness cache.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+
+	Returns:
+		The memory used by the fitness cache in bytes.
+
+	See Also:
+		<setFitnessCacheSize>, <getFitnessCacheHitRate>
+*/
+DLL_EXPORT long getFitnessCacheMemoryUsage(struct parameters *params);
 
 
 /*
@@ -1040,6 +1480,156 @@ DLL_EXPORT void printChromosome(struct chromosome *chromo, int weights);
 DLL_EXPORT void executeChromosome(struct chromosome *chromo, const double *inputs);
 
 
+/*
+	Function: executeChromosomeBatch
+		Executes the given chromosome over many samples.
+
+		Executes the given chromosome once for each of numSamples sets of inputs. The inputs of each sample are stored one after another in the inputs array, which must hold numSamples times the number of chromosome inputs doubles. The chromosome outputs of each sample are written one after another to the outputs array, which must hold numSamples times the number of chromosome outputs doubles.
+
+		The samples are executed in blocks, each active node being applied to a whole block of samples before moving onto the next node. This is much faster than calling <executeChromosome> for each sample when the number of samples is large. The outputs are identical to those given by <executeChromosome> and after returning the chromosome holds the state of the last sample.
+
+		Chromosomes containing recurrent connections are executed one sample at a time as each sample depends on the last.
+
+	Parameters:
+		chromo - pointer to an initialised chromosome structure.
+		inputs - array of doubles used as inputs to the chromosome, one sample after another
+		numSamples - the number of samples
+		outputs - array of doubles the chromosome outputs are written to, one sample after another
+
+	Example:
+
+		for a chromosome with two inputs and one output.
+
+			(begin code)
+
+			struct parameters *params = NULL;
+			struct chromosome *chromo = NULL;
+
+			double chromoInputs[] = {1, 2, 3, 4, 5, 6};
+			double chromoOutputs[3];
+
+			params = initialiseParameters(2, 10, 1, 2);
+			addNodeFunction(params, "add,sub,mul,sq,cube,sin");
+
+			chromo = initialiseChromosome(params);
+
+			executeChromosomeBatch(chromo, chromoInputs, 3, chromoOutputs);
+
+			freeParameters(params);
+			freeChromosome(chromo);
+
+			(end)
+
+	See Also:
+			<executeChromosome>
+*/
+DLL_EXPORT void executeChromosomeBatch(struct chromosome *chromo, const double *inputs, const int numSamples, double *outputs);
+
+
+/*
+	Function: initialiseExecutionState
+		Initialises an <executionState> for executing the given chromosome using <executeChromosomeWithState>.
+
+		The node values of the execution state start at zero. The execution state can be used with any chromosome of the same dimensions, i.e. the same number of inputs, nodes, outputs and node arity.
+
+	Parameters:
+		chromo - pointer to an initialised chromosome structure.
+
+	Returns:
+		A pointer to an initialised <executionState>.
+
+	See Also:
+		<freeExecutionState>, <executeChromosomeWithState>
+*/
+DLL_EXPORT struct executionState *initialiseExecutionState(struct chromosome *chromo);
+
+
+/*
+	Function: freeExecutionState
+		Frees the memory associated with the given <executionState>.
+
+	Parameters:
+		state - pointer to an initialised <executionState>.
+*/
+DLL_EXPORT void freeExecutionState(struct executionState *state);
+
+
+/*
+	Function: resetExecutionState
+		Resets all of the node values of the given <executionState> to zero.
+
+		As <resetChromosome>, this is useful when using recurrent connections.
+
+	Parameters:
+		state - pointer to an initialised <executionState>.
+*/
+DLL_EXPORT void resetExecutionState(struct executionState *state);
+
+
+/*
+	Function: executeChromosomeWithState
+		Executes the given chromosome without changing it.
+
+		Executes the given chromosome with the given inputs as <executeChromosome>, keeping the node values in the given <executionState> rather than in the chromosome and writing the chromosome outputs to the outputs array, which must hold the number of chromosome outputs doubles. The outputs are identical to those given by <executeChromosome>, including when the chromosome has been compiled using <compileChromosome>.
+
+		As the chromosome is not changed, many threads can execute the same chromosome at once without locking or copying it, each with its own execution state. The chromosome must not be changed, for example mutated, while it is being executed. Custom node functions may then be called from several threads at once. With recurrent connections each execution state holds the state carried between executions.
+
+	Parameters:
+		chromo - pointer to an initialised chromosome structure.
+		state - pointer to an <executionState> initialised for a chromosome of the same dimensions.
+		inputs - array of doubles used as inputs to the chromosome
+		outputs - array of doubles the chromosome outputs are written to
+
+	Example:
+
+		Each thread executing the same chromosome.
+
+			(begin code)
+
+			#pragma omp parallel
+			{
+				struct executionState *state = initialiseExecutionState(chromo);
+				double outputs[1];
+				int i;
+
+				#pragma omp for
+				for (i = 0; i < numSamples; i++) {
+					executeChromosomeWithState(chromo, state, getDataSetSampleInputs(data, i), outputs);
+				}
+
+				freeExecutionState(state);
+			}
+
+			(end)
+
+	See Also:
+			<executeChromosome>, <initialiseExecutionState>
+*/
+DLL_EXPORT void executeChromosomeWithState(struct chromosome *chromo, struct executionState *state, const double *inputs, double *outputs);
+
+
+/*
+	Function: compileChromosome
+		Compiles the given chromosome to native code.
+
+		The active nodes of the chromosome are written out as straight line C code, compiled into a shared object and loaded at run time. Subsequent calls to <executeChromosome> then run the native code instead of interpreting the chromosome, giving identical outputs. The compiler used is given by the CGP_CC environment variable, or cc if it is not set.
+
+		Compiled code is cached by the active genotype, so compiling a chromosome identical to one already compiled is cheap. Compiled code is never unloaded, so the cache holds at most 4096 compiled chromosomes; once it is full, chromosomes not already in it are not compiled and are interpreted instead. The compiled code is discarded whenever the chromosome is mutated or otherwise changed and must then be compiled again.
+
+		If the chromosome uses custom node functions or the rand node function, no compiler is available or the platform cannot load shared objects, the chromosome is left unchanged and continues to be interpreted.
+
+	Parameters:
+		chromo - pointer to an initialised chromosome structure.
+
+	Returns:
+		1 if the chromosome was compiled and 0 otherwise.
+
+	See Also:
+			<executeChromosome>, <setCompileChromosomes>
+*/
+DLL_EXPORT int compileChromosome(struct chromosome *chromo);
+
+
 
 /*
 	Function: getChromosomeOutput
@@ -1374,6 +1964,24 @@ DLL_EXPORT int getNumChromosomeActiveConnections(struct chromosome *chromo);
 DLL_EXPORT int getChromosomeGenerations(struct chromosome *chromo);
 
 
+/*
+	Function: getChromosomeSavedEvaluations
+		Gets the number of fitness evaluations saved by <runCGP> while finding the given chromosome.
+
+		Counts the children which took their fitness from an identical chromosome rather than being evaluated. See <setReuseFitness>.
+
+	Parameters:
+		chromo - pointer to initialised chromosome structure.
+
+	Returns:
+		Number of fitness evaluations saved
+
+	See Also:
+		<getChromosomeGenerations> <setReuseFitness>
+*/
+DLL_EXPORT int getChromosomeSavedEvaluations(struct chromosome *chromo);
+
+
 /*
 	Title: DataSet Functions
 
@@ -1428,11 +2036,63 @@ DLL_EXPORT int getChromosomeGenerations(struct chromosome *chromo);
 DLL_EXPORT struct dataSet *initialiseDataSetFromArrays(int numInputs, int numOutputs, int numSamples, double *inputs, double *outputs);
 
 
+/*
+	Function: initialiseDataSetView
+
+	Initialises a <dataSet> structure which refers to the given arrays of inputs and outputs rather than copying them.
+
+	Sample i of the view is row samples[i] of the arrays, or row i if samples is NULL, so a subset of the rows, in any order and with repeats, can be used without copying. The rows of the inputs start inputStride values apart and those of the outputs outputStride values apart. The inputs of a row are the numInputs consecutive values at the start of the row and likewise for the outputs, so a range of columns of a larger matrix can be used by passing a pointer to the first of them; the inputs and outputs may be columns of the same matrix. Columns which are not consecutive must be copied, for example using <initialiseDataSetFromArrays>.
+
+	The view can be used wherever a <dataSet> can. Only the sample indices are stored by the view and the samples array is not kept. The arrays must not be freed before the view is freed using <freeDataSet>, which does not free them, and must not be changed while the view is in use: a bit packed copy of Boolean data sets is made when the view is initialised, and <setDataSetLayout> and <setPrecision> make further copies when used.
+
+	An input stride less than numInputs, or an output stride less than numOutputs, is an error.
+
+	Parameters:
+		numInputs - number of inputs per data sample
+		numOutputs - number of outputs per data sample
+		numSamples - number of data samples
+		inputs - pointer to the first input of the first row
+		inputStride - number of values from the start of one row of inputs to the next
+		outputs - pointer to the first output of the first row
+		outputStride - number of values from the start of one row of outputs to the next
+		samples - array of numSamples row indices, or NULL to use the first numSamples rows
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	Example:
+
+		Using the even rows of a matrix whose first ten columns are the inputs and last column the output.
+
+		(begin code)
+		double matrix[1000][11];
+		int evenRows[500];
+		struct dataSet *trainingData;
+
+		for (i = 0; i < 500; i++) {
+			evenRows[i] = 2 * i;
+		}
+
+		trainingData = initialiseDataSetView(10, 1, 500, matrix[0], 11, &matrix[0][10], 11, evenRows);
+		(end)
+
+	See Also:
+		<freeDataSet>, <initialiseDataSetFromArrays>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetView(int numInputs, int numOutputs, int numSamples, double *inputs, int inputStride, double *outputs, int outputStride, const int *samples);
+
+
 /*
 	Function: initialiseDataSetFromFile
 
 	Initialises a <dataSet> structures using the given file.
 
+	The whole file is read, or memory mapped where possible, and large files are split into chunks of whole lines which are parsed in parallel using the number of threads set using <setDataSetParsingThreads>, one by default. Lines may be any length. Values may be separated by commas, spaces or tabs, lines without values are ignored, and each value is read exactly as by the C library's atof.
+
+	A file whose number of samples differs from that given in its header, or with a sample which does not have one value for each input and output, is an error.
+
+	Binary files saved by <saveDataSetBinary> are recognised by their header and loaded using <initialiseDataSetFromBinaryFile>.
+
 	Parameters:
 		file - the location of the file to be loaded into the <dataSet> structure
 
@@ -1460,16 +2120,109 @@ DLL_EXPORT struct dataSet *initialiseDataSetFromArrays(int numInputs, int numOut
 		(end)
 
 	See Also:
-		<freeDataSet>, <initialiseDataSetFromArrays>, <printDataSet>
+		<freeDataSet>, <initialiseDataSetFromArrays>, <printDataSet>, <setDataSetParsingThreads>
 */
 DLL_EXPORT struct dataSet *initialiseDataSetFromFile(char const *file);
 
 
+/*
+	Function: setDataSetParsingThreads
+
+	Sets the number of threads used by <initialiseDataSetFromFile> to parse text files.
+
+	Loading a <dataSet> does not take a <parameters> structure, so the number of threads set using <setNumThreads> does not apply. The setting applies to all later calls of <initialiseDataSetFromFile>, and to <initialiseDataSetFromFileCached> when it parses the text file. Like <setNumThreads>, the OMP_NUM_THREADS environment variable is ignored. The default is one thread.
+
+	Values <1 are invalid. If an invalid value is given a warning is displayed and the value is left unchanged.
+
+	Note:
+		In order for the CGP-Library to use multiple threads it must be compiled with openMP flag set (-fopenmp for gcc/mingw).
+
+	Parameters:
+		numThreads - the number of threads used to parse text dataSet files.
+
+	See Also:
+		<initialiseDataSetFromFile>, <setNumThreads>
+*/
+DLL_EXPORT void setDataSetParsingThreads(int numThreads);
+
+
+/*
+	Function: initialiseDataSetFromBinaryFile
+
+	Initialises a <dataSet> structure using a binary file saved by <saveDataSetBinary>.
+
+	Where memory mapping is available the file is mapped into memory and used in place, without being read or parsed; its pages are read from disk as they are first used. The mapping is private, so changing the values of the <dataSet> does not change the file. Elsewhere the values are read into memory. <initialiseDataSetFromFile> also loads binary files, recognising them by their header.
+
+	A file which is not a binary dataSet file, was saved by a later version of CGP-Library, was saved on a machine with a different byte order or is shorter than its header states is an error.
+
+	Parameters:
+		file - the location of the binary dataSet file.
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	See Also:
+		<saveDataSetBinary>, <initialiseDataSetFromFile>, <initialiseDataSetFromFileCached>, <freeDataSet>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromBinaryFile(char const *file);
+
+
+/*
+	Function: initialiseDataSetFromFileCached
+
+	Initialises a <dataSet> structure using a text file as <initialiseDataSetFromFile>, keeping a binary copy next to it.
+
+	The binary copy has the name of the text file followed by '.bin'. The binary copy records the size and modification time, to the nanosecond, of the text file it was made from. If it exists, has a version and byte order this CGP-Library reads and the text file has not changed size or modification time since, it is loaded using <initialiseDataSetFromBinaryFile> and the text file is not parsed. Otherwise the text file is parsed and the binary copy is saved using <saveDataSetBinary>, so later loads are fast. If the binary copy cannot be saved a warning is displayed.
+
+	Parameters:
+		file - the location of the text dataSet file.
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	See Also:
+		<initialiseDataSetFromFile>, <initialiseDataSetFromBinaryFile>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromFileCached(char const *file);
+
+
+/*
+	Function: initialiseDataSetStream
+
+	Initialises a <dataSet> structure which streams the samples of a binary file saved by <saveDataSetBinary> from disk rather than holding them in memory, for data sets larger than memory.
+
+	The samples are read in blocks of blockSize samples, rounded up to a multiple of 128. When <runCGP> or <repeatCGP> evaluate the children of a generation using the default supervised learning fitness function each block is read once and all of the children are evaluated on it while it is in cache, in parallel if <setNumThreads> is greater than one, as the next block is read. The data set is therefore read once per generation rather than once per child. Where supported the operating system is also asked to read ahead.
+
+	The fitness found is identical to that of the same data set held in memory, evaluated in double precision. <setPrecision>, Boolean evaluation, incremental evaluation and screening are not used with streamed data sets and they have no layout.
+
+	<getDataSetSampleInputs> and the other sample accessors read the block holding the sample into memory kept by the calling thread. The pointers they return are valid until a sample of another block is accessed by that thread or the <dataSet> is freed.
+
+	Parameters:
+		file - the location of the binary dataSet file.
+		blockSize - the number of samples read at a time.
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	Example:
+
+		(begin code)
+		data = initialiseDataSetStream("large.data.bin", 65536);
+		(end)
+
+	See Also:
+		<saveDataSetBinary>, <initialiseDataSetFromBinaryFile>, <freeDataSet>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetStream(char const *file, int blockSize);
+
+
 /*
 	Function: freeDataSet
 
 	Frees <dataSet> instance.
 
+	The arrays referred to by a view initialised using <initialiseDataSetView> are not freed.
+
 	Parameters:
 		data - pointer to dataSet structure.
 
@@ -1502,11 +2255,28 @@ DLL_EXPORT void printDataSet(struct dataSet *data);
 		fileName - char array giving the location of the dataSet to be saved.
 
 	See Also:
-		<initialiseDataSetFromFile>, <freeDataSet>
+		<initialiseDataSetFromFile>, <freeDataSet>, <saveDataSetBinary>
 */
 DLL_EXPORT void saveDataSet(struct dataSet *data, char const *fileName);
 
 
+/*
+	Function: saveDataSetBinary
+
+	Saves the given <dataSet> to a binary file which can be read using <initialiseDataSetFromBinaryFile> or <initialiseDataSetFromFile>.
+
+	The file starts with a 64 byte header: the eight characters 'CGPDATA' and a zero, the format version, a byte order marker, the number of inputs and outputs as 32 bit integers, the number of samples as a 64 bit integer, the offsets of the inputs and outputs in the file, flags recording whether every value is 0 or 1, so that loading the file need not check them, and a stamp used by <initialiseDataSetFromFileCached>. The inputs and then the outputs follow, sample by sample, as doubles in the byte order of the machine which saved the file, each starting at an offset which is a multiple of 64 bytes. The values are saved exactly.
+
+	Parameters:
+		data - pointer to <dataSet> structure.
+		fileName - char array giving the location of the dataSet to be saved.
+
+	See Also:
+		<saveDataSet>, <initialiseDataSetFromBinaryFile>
+*/
+DLL_EXPORT void saveDataSetBinary(struct dataSet *data, char const *fileName);
+
+
 /*
 	Function: getNumDataSetInputs
 		Gets the number of <dataSet> inputs.
@@ -1625,6 +2395,65 @@ DLL_EXPORT double *getDataSetSampleOutputs(struct dataSet *data, int sample);
 DLL_EXPORT double getDataSetSampleOutput(struct dataSet *data, int sample, int output);
 
 
+/*
+	Function: setDataSetLayout
+
+	Sets the layout of the given <dataSet>, 'row' or 'column'.
+
+	In the row layout, the default, the inputs and outputs are stored sample by sample. In the column layout they are also stored column by column: all samples of the first input, then all samples of the second and so on, each column starting on a 64 byte boundary. The default fitness function then copies whole input columns, or reads them in place, rather than gathering each input from every sample, and custom fitness functions can stream the columns using <getDataSetInputColumn> and <getDataSetOutputColumn>. The fitness found is identical in either layout. The column layout takes twice the memory.
+
+	If an invalid layout is given a warning is displayed and the layout is left unchanged.
+
+	Parameters:
+		data - pointer to an initialised <dataSet> structure.
+		layout - the layout, 'row' or 'column'.
+
+	Example:
+
+		(begin code)
+		setDataSetLayout(data, "column");
+		(end)
+
+	See Also:
+		<getDataSetInputColumn>, <getDataSetOutputColumn>
+*/
+DLL_EXPORT void setDataSetLayout(struct dataSet *data, char const *layout);
+
+
+/*
+	Function: getDataSetInputColumn
+		Gets the values of the given input for every sample of a <dataSet> in the column layout.
+
+	Parameters:
+		data - pointer to an initialised <dataSet> structure.
+		input - index of the input.
+
+	Returns:
+		Pointer to an array of the input value of each sample, aligned to 64 bytes, or NULL if the dataSet is not in the column layout.
+
+	See Also:
+		<setDataSetLayout>, <getDataSetOutputColumn>
+*/
+DLL_EXPORT const double *getDataSetInputColumn(struct dataSet *data, int input);
+
+
+/*
+	Function: getDataSetOutputColumn
+		Gets the values of the given output for every sample of a <dataSet> in the column layout.
+
+	Parameters:
+		data - pointer to an initialised <dataSet> structure.
+		output - index of the output.
+
+	Returns:
+		Pointer to an array of the output value of each sample, aligned to 64 bytes, or NULL if the dataSet is not in the column layout.
+
+	See Also:
+		<setDataSetLayout>, <getDataSetInputColumn>
+*/
+DLL_EXPORT const double *getDataSetOutputColumn(struct dataSet *data, int output);
+
+
 /*
 	Title: Results Functions
 */
@@ -1889,6 +2718,8 @@ DLL_EXPORT struct results* repeatCGP(struct parameters *params, struct dataSet *
 
 		By default the current time is used as the random number seed. When a random number seed is specified the CGP-Library will produce the same results if used in the same way.
 
+		CGP-Library uses its own xoshiro256** random number generator rather than rand(), with a separate stream for each thread. Each run of <repeatCGP> and each child evaluated by <runCGP> is given its own stream derived from the seed, so the same seed gives the same results whatever number of threads is set using <setNumThreads>. The seed only applies to the calling thread.
+
 	Note:
 		<setRandomNumberSeed> *must* be called *after* <initialiseParameters> otherwise the time will be used as the random number seed.
 